@@ -10,12 +10,16 @@ namespace Custom {
 		EditorPropertyBool() {}
 
 		void Edit(PrettyEngine::SerializedField* serializedField) override {
-			if (serializedField->type == SERIAL_TOKEN(bool)) {
+			if (serializedField->type == this->_boolType) {
 				bool buffer = serializedField->value == "true" ? true : false;
 				ImGui::Checkbox(serializedField->name.c_str(), &buffer);
 				serializedField->value = buffer ? "true" : "false";
 			}
 		}
+
+	private:
+		/// Interned once, the field types are compared by address.
+		const PrettyEngine::InternedString _boolType = SERIAL_TOKEN(bool);
 	};
 }
 
@@ -9,10 +9,15 @@ namespace Custom {
 	class EditorPropertyMesh : public PrettyEngine::PropertyEditor {
 	public:
 		void Edit(PrettyEngine::SerializedField* serializedField) override { 
-			if (serializedField->type == "PrettyEngine::Mesh" || serializedField->type == "Mesh") {
+			if (serializedField->type == this->_meshType || serializedField->type == this->_shortMeshType) {
 				ImGui::Text("Only the \"rect\" mesh is available for now.");
 			}
 		}
+
+	private:
+		/// Interned once, the field types are compared by address.
+		const PrettyEngine::InternedString _meshType = SERIAL_TOKEN(PrettyEngine::Mesh);
+		const PrettyEngine::InternedString _shortMeshType = SERIAL_TOKEN(Mesh);
 	};
 }
 
@@ -14,22 +14,22 @@ namespace Custom {
 	class EditorPropertyNumber : public PrettyEngine::PropertyEditor {
 	public:
 		void Edit(PrettyEngine::SerializedField* serializedField) override { 
-			if (serializedField->type == "int") {
+			if (serializedField->type == this->_intType) {
 				int value = std::stoi(serializedField->value);
 				ImGui::InputInt(serializedField->name.c_str(), &value);
 				serializedField->value = std::to_string(value);
 			}
-			else if (serializedField->type == "float") {
+			else if (serializedField->type == this->_floatType) {
 				float value = std::stof(serializedField->value);
 				ImGui::InputFloat(serializedField->name.c_str(), &value);
 				serializedField->value = std::to_string(value);
 			}
-			else if (serializedField->type == "double") {
+			else if (serializedField->type == this->_doubleType) {
 				double value = std::stod(serializedField->value);
 				ImGui::InputDouble(serializedField->name.c_str(), &value);
 				serializedField->value = std::to_string(value);
 			}
-			else if (serializedField->type == SERIAL_TOKEN(glm::vec3)) {
+			else if (serializedField->type == this->_vec3Type) {
 				auto parsed = PrettyEngine::ParseCSVLine(serializedField->value);
 				float buffer[3] = {0.0f, 0.0f, 0.0f};
 				buffer[0] = std::stof(parsed[0]);
@@ -49,7 +49,7 @@ namespace Custom {
 					newValue += ';';
 				}
 				serializedField->value = newValue;
-			} else if (serializedField->type == SERIAL_TOKEN(glm::vec4)) {
+			} else if (serializedField->type == this->_vec4Type) {
 				auto parsed = PrettyEngine::ParseCSVLine(serializedField->value);
 				float buffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 				buffer[0] = std::stof(parsed[0]);
@@ -70,7 +70,7 @@ namespace Custom {
 					newValue += ';';
 				}
 				serializedField->value = newValue;
-			} else if (serializedField->type == SERIAL_TOKEN(glm::vec2)) {
+			} else if (serializedField->type == this->_vec2Type) {
 				auto parsed = PrettyEngine::ParseCSVLine(serializedField->value);
 				float buffer[2] = {0.0f, 0.0f};
 				buffer[0] = std::stof(parsed[0]);
@@ -84,6 +84,15 @@ namespace Custom {
 				serializedField->value = newValue;
 			}
 		}
+
+	private:
+		/// Interned once, the field types are compared by address.
+		const PrettyEngine::InternedString _intType = SERIAL_TOKEN(int);
+		const PrettyEngine::InternedString _floatType = SERIAL_TOKEN(float);
+		const PrettyEngine::InternedString _doubleType = SERIAL_TOKEN(double);
+		const PrettyEngine::InternedString _vec2Type = SERIAL_TOKEN(glm::vec2);
+		const PrettyEngine::InternedString _vec3Type = SERIAL_TOKEN(glm::vec3);
+		const PrettyEngine::InternedString _vec4Type = SERIAL_TOKEN(glm::vec4);
 	};
 }
 
@@ -11,13 +11,17 @@ namespace Custom {
 		EditorPropertyString() {}
 
 		void Edit(PrettyEngine::SerializedField* serializedField) override {
-			if (serializedField->type == SERIAL_TOKEN(std::string)) {
+			if (serializedField->type == this->_stringType) {
 				char buffer[100];
 				strcpy_s(buffer, serializedField->value.c_str());
 				ImGui::InputText(serializedField->name.c_str(), buffer, 100);
 				serializedField->value = buffer;
 			}
 		}
+
+	private:
+		/// Interned once, the field types are compared by address.
+		const PrettyEngine::InternedString _stringType = SERIAL_TOKEN(std::string);
 	};
 }
 
@@ -1,90 +1,67 @@
 #pragma once
 
 #include <PrettyEngine/render/RenderFeature.hpp>
+#include <PrettyEngine/render/uniformBuffer.hpp>
 #include <PrettyEngine/debug/debug.hpp>
 #include <PrettyEngine/render/light.hpp>
 
+#include <algorithm>
+
 namespace Custom {
 	class RF_Light: public PrettyEngine::RenderFeature {
 	public:
-		void OnInit() override {
-            _flattenedLightsPosition.clear();
-            _flattenedLightsColor.clear();
-            _flattenedLightsFactor.clear();
-            _flattenedLightsDeferredFactor.clear();
-            _flattenedLightsOpacityFactorEffect.clear();
-            
-            _flattenedLightsLayer.clear();
-            _flattenedRadius.clear();
-
-            _flattenedLightsSpotLight.clear();
-            _flattenedLightsDirection.clear();
-            _flattenedLightsCutOff.clear();
-            
-            for (auto  & light : *this->lights) {
-                _flattenedLightsOpacityFactorEffect.push_back(light->opacityFactorEffect);
-
-                _flattenedLightsPosition.push_back(light->position.x);
-                _flattenedLightsPosition.push_back(light->position.y);
-                _flattenedLightsPosition.push_back(light->position.z);
+		~RF_Light() {
+			if (_lightsBuffer.Valid()) {
+				_lightsBuffer.Destroy();
+			}
+		}
 
-                _flattenedLightsColor.push_back(light->color.x);
-                _flattenedLightsColor.push_back(light->color.y);
-                _flattenedLightsColor.push_back(light->color.z);
+		/// Upload the lights once per frame to the LightsData block, shared by every program.
+		void OnInit() override {
+			// OnCreated is not called from the OpenGL thread
+			if (!_lightsBuffer.Valid()) {
+				_lightsBuffer.Create(UNIFORM_BUFFER_LIGHTS);
+			}
 
-                _flattenedLightsFactor.push_back(light->lightFactor);
+			if (this->lights->size() > UNIFORM_BUFFER_MAX_LIGHTS) {
+				DebugLog(LOG_WARNING, "Only the first " << UNIFORM_BUFFER_MAX_LIGHTS << " lights are rendered", false);
+			}
 
-                _flattenedLightsDeferredFactor.push_back(light->deferredFactor);
+			const auto count = std::min<size_t>(this->lights->size(), UNIFORM_BUFFER_MAX_LIGHTS);
+			_lightsData.lightsCount = static_cast<int>(count);
 
-                _flattenedLightsDirection.push_back(light->spotDirection.x);
-                _flattenedLightsDirection.push_back(light->spotDirection.y);
-                _flattenedLightsDirection.push_back(light->spotDirection.z);
-                
-                _flattenedLightsSpotLight.push_back((int)(light->lightType == PrettyEngine::LightType::SpotLight));
-                _flattenedLightsCutOff.push_back(light->spotLightCutOff);
+			for (size_t i = 0; i < count; i++) {
+				auto light = (*this->lights)[i];
 
-                _flattenedLightsLayer.push_back(light->lightLayer);
+				_lightsData.position[i] = glm::vec4(light->position, light->radius);
+				_lightsData.color[i] = glm::vec4(light->color, light->lightFactor);
+				_lightsData.parameters[i] = glm::vec4(
+					light->deferredFactor,
+					light->opacityFactorEffect,
+					light->spotLightCutOff,
+					light->lightType == PrettyEngine::LightType::SpotLight ? 1.0f : 0.0f
+				);
+				_lightsData.direction[i] = glm::vec4(light->spotDirection, 0.0f);
+				_lightsData.layer[i] = glm::ivec4(light->lightLayer, 0, 0, 0);
+			}
 
-                _flattenedRadius.push_back(light->radius);
-            }
+			_lightsBuffer.Update(_lightsData);
 		}
 
 		void OnUniform(PrettyEngine::VisualObject *visualObject) override {
 			auto shaderProgram = visualObject->renderModel->shaderProgram;
 
-			glUniform1i(shaderProgram->uniforms["UseLight"], visualObject->useLight);
-            if (visualObject->useLight) {
-                glUniform1i(shaderProgram->uniforms["LightsCount"], this->lights->size());
-                glUniform1i(shaderProgram->uniforms["LightLayer"], visualObject->lightLayer);
-                
-                glUniform1iv(shaderProgram->uniforms["LightsLayer"], this->lights->size(), _flattenedLightsLayer.data());
-
-                glUniform3fv(shaderProgram->uniforms["LightsPosition"], this->lights->size(), _flattenedLightsColor.data());
-                glUniform3fv(shaderProgram->uniforms["LightsColor"], this->lights->size(), _flattenedLightsColor.data());
-                
-                glUniform1fv(shaderProgram->uniforms["LightsRadius"], this->lights->size(), _flattenedRadius.data());
-                glUniform1fv(shaderProgram->uniforms["LightsFactor"], this->lights->size(), _flattenedLightsFactor.data());
-                glUniform1fv(shaderProgram->uniforms["LightsDeferredFactor"], this->lights->size(), _flattenedLightsDeferredFactor.data());
-                glUniform1fv(shaderProgram->uniforms["LightsOpacityFactorEffect"], this->lights->size(), _flattenedLightsOpacityFactorEffect.data());
-            
-                glUniform1iv(shaderProgram->uniforms["SpotLight"], this->lights->size(), _flattenedLightsSpotLight.data());
-                glUniform3fv(shaderProgram->uniforms["SpotLightDirection"], this->lights->size(), _flattenedLightsDirection.data());
-                glUniform1fv(shaderProgram->uniforms["SpotLightCutOff"], this->lights->size(), _flattenedLightsCutOff.data());
-            }
+			glUniform1i(shaderProgram->GetUniform(PrettyEngine::Uniform::UseLight), visualObject->useLight);
+			if (visualObject->useLight) {
+				glUniform1i(shaderProgram->GetUniform(PrettyEngine::Uniform::LightLayer), visualObject->lightLayer);
+			}
 		}
 
-    private:
-        std::vector<float> _flattenedLightsPosition;
-        std::vector<float> _flattenedLightsColor;
-        std::vector<float> _flattenedLightsFactor;
-        std::vector<float> _flattenedLightsDeferredFactor;
-        std::vector<float> _flattenedLightsOpacityFactorEffect;
-        
-        std::vector<int> _flattenedLightsLayer;
-        std::vector<float> _flattenedRadius;
+		/// useLight and lightLayer are part of the instance state.
+		bool SupportInstancing() const override { return true; }
 
-        std::vector<int> _flattenedLightsSpotLight;
-        std::vector<float> _flattenedLightsDirection;
-        std::vector<float> _flattenedLightsCutOff;
+	private:
+		PrettyEngine::UniformBuffer<PrettyEngine::LightsUniforms> _lightsBuffer;
+		PrettyEngine::LightsUniforms _lightsData = {};
 	};
 }
@@ -6,11 +6,62 @@ set(file_prefix "/******************************************************
  ******************************************************/"
 )
 
+# Rewriting an unchanged header would rebuild everything that include it, so the headers are generated aside then copied only if different.
+function(update_generated_file generated path)
+	execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${generated}" "${path}")
+endfunction()
+
+# Every builtin asset is a byte array of a single translation unit, gzip compressed when it is smaller, and the headers only have macros reading them through the index.
+file(MAKE_DIRECTORY "${CMAKE_BINARY_DIR}/generated")
+
+set(builtin_data_buffer "")
+set(builtin_index_entries "")
+# Paths of every builtin asset, each one with its file in builtin_asset_file_<path>.
+set(builtin_paths "")
+
+function(embed_builtin_asset asset path)
+	file(SIZE ${asset} size)
+	file(READ ${asset} hex HEX)
+	set(compression "BUILTIN_ASSET_STORED")
+
+	if(size GREATER 0)
+		set(compressed "${CMAKE_BINARY_DIR}/generated/builtin_asset.gz")
+		file(ARCHIVE_CREATE OUTPUT ${compressed} PATHS ${asset} FORMAT raw COMPRESSION GZip COMPRESSION_LEVEL 9)
+		file(READ ${compressed} compressed_hex HEX)
+		file(REMOVE ${compressed})
+
+		string(LENGTH "${hex}" hex_length)
+		string(LENGTH "${compressed_hex}" compressed_length)
+		if(compressed_length LESS hex_length)
+			# The gzip header has the time of compression, cleared so the generated file only change with the assets.
+			string(SUBSTRING "${compressed_hex}" 0 8 header)
+			string(SUBSTRING "${compressed_hex}" 16 -1 body)
+			set(hex "${header}00000000${body}")
+			set(compression "BUILTIN_ASSET_GZIP")
+		endif()
+	else()
+		set(hex "00")
+	endif()
+
+	string(LENGTH "${hex}" hex_length)
+	math(EXPR data_size "${hex_length} / 2")
+	if(size EQUAL 0)
+		set(data_size 0)
+	endif()
+
+	string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+	string(MAKE_C_IDENTIFIER "asset_${path}" symbol)
+
+	set(builtin_data_buffer "${builtin_data_buffer}\n\tstatic const unsigned char ${symbol}[] = { ${bytes} }\;\n" PARENT_SCOPE)
+	set(builtin_index_entries "${builtin_index_entries}\n\t\t{ \"${path}\", ${symbol}, ${data_size}, ${size}, ${compression} }," PARENT_SCOPE)
+endfunction()
+
 ## Engine Built-in
 
 file(GLOB_RECURSE assets "${CMAKE_SOURCE_DIR}/assets/ENGINE_BUILTIN/*")
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${assets})
 
-set(assets_buffer "#pragma once\n\n${file_prefix}\n")
+set(assets_buffer "#pragma once\n\n${file_prefix}\n\n#include <PrettyEngine/builtinAssets.hpp>\n")
 
 foreach(asset ${assets})
 
@@ -20,23 +71,24 @@ string(REPLACE "-" "_" name ${name})
 
 string(TOUPPER ${name} name)
 
-file(READ ${asset} asset_content)
-
-string(REPLACE ";" "\;" asset_content "${asset_content}")
+file(RELATIVE_PATH path "${CMAKE_SOURCE_DIR}/assets/ENGINE_BUILTIN" ${asset})
 
-set(var_type "const char*")
+list(APPEND builtin_paths "${path}")
+set("builtin_asset_file_${path}" "${asset}")
 
-string(APPEND assets_buffer "\nstatic ${var_type} ASSET_BUILTIN_${name} = R\"(${asset_content})\"\;\n")
+string(APPEND assets_buffer "\n#define ASSET_BUILTIN_${name} PrettyEngine::GetBuiltinAsset(\"${path}\")\n")
 
 endforeach()
 
-file(WRITE "${CMAKE_SOURCE_DIR}/include/PrettyEngine/assets/builtin.hpp" ${assets_buffer})
+file(WRITE "${CMAKE_BINARY_DIR}/generated/builtin.hpp" ${assets_buffer})
+update_generated_file("${CMAKE_BINARY_DIR}/generated/builtin.hpp" "${CMAKE_SOURCE_DIR}/include/PrettyEngine/assets/builtin.hpp")
 
 ## Engine Compiled
 
 file(GLOB_RECURSE assets "${CMAKE_SOURCE_DIR}/assets/ENGINE_COMPILED/*")
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${assets})
 
-set(assets_buffer "#pragma once\n\n${file_prefix}\n")
+set(assets_buffer "#pragma once\n\n${file_prefix}\n\n#include <PrettyEngine/builtinAssets.hpp>\n")
 
 foreach(asset ${assets})
 
@@ -46,14 +98,31 @@ string(REPLACE "-" "_" name ${name})
 
 string(TOUPPER ${name} name)
 
-file(READ ${asset} asset_content)
+file(RELATIVE_PATH path "${CMAKE_SOURCE_DIR}/assets/ENGINE_COMPILED" ${asset})
+
+list(APPEND builtin_paths "compiled/${path}")
+set("builtin_asset_file_compiled/${path}" "${asset}")
 
-string(REPLACE ";" "\;" asset_content "${asset_content}")
+string(APPEND assets_buffer "\n#define ASSET_COMPILED_${name} reinterpret_cast<const unsigned char*>(PrettyEngine::GetBuiltinAsset(\"compiled/${path}\"))\n")
 
-set(var_type "unsigned char*")
+endforeach()
+
+file(WRITE "${CMAKE_BINARY_DIR}/generated/bin.hpp" ${assets_buffer})
+update_generated_file("${CMAKE_BINARY_DIR}/generated/bin.hpp" "${CMAKE_SOURCE_DIR}/include/PrettyEngine/assets/bin.hpp")
 
-string(APPEND assets_buffer "\nstatic ${var_type} ASSET_COMPILED_${name} = R\"(${asset_content})\"\;\n")
+## Builtin asset data
 
+# The index is searched by binary search, so the entries are generated in the order of their sorted paths.
+list(SORT builtin_paths)
+foreach(path ${builtin_paths})
+	embed_builtin_asset("${builtin_asset_file_${path}}" "${path}")
 endforeach()
 
-file(WRITE "${CMAKE_SOURCE_DIR}/include/PrettyEngine/assets/bin.hpp" ${assets_buffer})
+set(assets_buffer "${file_prefix}\n\n#include <PrettyEngine/builtinAssets.hpp>\n\nnamespace PrettyEngine {")
+string(APPEND assets_buffer "${builtin_data_buffer}")
+# The last entry is only there so the array is never empty.
+string(APPEND assets_buffer "\n\tstatic const BuiltinAssetEntry builtinAssetIndex[] = {${builtin_index_entries}\n\t\t{ nullptr, nullptr, 0, 0, BUILTIN_ASSET_STORED },\n\t}\;\n")
+string(APPEND assets_buffer "\n\tstd::span<const BuiltinAssetEntry> GetBuiltinAssetIndex() {\n\t\treturn std::span<const BuiltinAssetEntry>(builtinAssetIndex, std::size(builtinAssetIndex) - 1)\;\n\t}\n}\n")
+
+file(WRITE "${CMAKE_BINARY_DIR}/generated/next/builtinAssetData.cpp" ${assets_buffer})
+update_generated_file("${CMAKE_BINARY_DIR}/generated/next/builtinAssetData.cpp" "${CMAKE_BINARY_DIR}/generated/builtinAssetData.cpp")
@@ -0,0 +1,13 @@
+# Benchmarks
+
+project(bench C CXX)
+
+add_executable(bench_serialization "${CMAKE_SOURCE_DIR}/bench/serialization.cpp")
+target_link_libraries(bench_serialization PRIVATE custom components renderFeatures)
+
+if(WIN32)
+	target_link_libraries(bench_serialization PRIVATE psapi)
+endif()
+
+add_executable(bench_database "${CMAKE_SOURCE_DIR}/bench/database.cpp")
+target_link_libraries(bench_database PRIVATE pretty)
@@ -0,0 +1,169 @@
+/*
+ * Database benchmark, write assets one by one then in one transaction, the way AssetDataBase does, and print the results as JSON.
+ * Usage: bench_database [--writes N] [--size N] [--iterations N] [--output file.json]
+*/
+
+#include <PrettyEngine/data.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct BenchConfig {
+	size_t writes = 500;
+	/// Bytes of text per write.
+	size_t size = 256;
+	size_t iterations = 5;
+	std::string output;
+};
+
+struct BenchResult {
+	std::string name;
+	double bestMs = 0;
+	double averageMs = 0;
+	size_t items = 0;
+};
+
+static const std::string upsertText =
+	"INSERT INTO \"any\" (name, path, text, bin) VALUES (?2, ?1, ?3, '') "
+	"ON CONFLICT (path, name) DO UPDATE SET text = excluded.text";
+
+static bool ParseArguments(int argc, char** argv, BenchConfig* config) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (i + 1 >= argc) {
+			std::cerr << "Missing value for: " << argument << std::endl;
+			return false;
+		}
+
+		std::string value = argv[++i];
+		if (argument == "--writes") {
+			config->writes = std::stoull(value);
+		} else if (argument == "--size") {
+			config->size = std::stoull(value);
+		} else if (argument == "--iterations") {
+			config->iterations = std::max<size_t>(1, std::stoull(value));
+		} else if (argument == "--output") {
+			config->output = value;
+		} else {
+			std::cerr << "Unknown argument: " << argument << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Same table and pragmas as assets.db.
+static void SetupDataBase(PrettyEngine::DataBase* dataBase) {
+	dataBase->SetJournalMode(PrettyEngine::JournalMode::WAL);
+	dataBase->SetSynchronous(PrettyEngine::SynchronousLevel::Normal);
+	dataBase->ExecuteSQL("CREATE TABLE IF NOT EXISTS \"any\" (name TEXT, path TEXT, text TEXT, bin BLOB)");
+	dataBase->ExecuteSQL("CREATE UNIQUE INDEX IF NOT EXISTS any_path_name ON \"any\" (path, name)");
+}
+
+static void Write(PrettyEngine::DataBase* dataBase, BenchConfig* config, const std::string& text) {
+	for (size_t i = 0; i < config->writes; i++) {
+		auto statement = dataBase->GetStatement(upsertText);
+		statement->Bind(1, "bench").Bind(2, "asset" + std::to_string(i)).Bind(3, text);
+		statement->Step();
+		statement->Reset();
+	}
+}
+
+template<typename Function>
+static BenchResult Measure(std::string name, size_t iterations, size_t items, Function function) {
+	BenchResult result;
+	result.name = name;
+	result.items = items;
+
+	double total = 0;
+	for (size_t i = 0; i < iterations; i++) {
+		auto start = std::chrono::steady_clock::now();
+		function();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		total += elapsed.count();
+		if (i == 0 || elapsed.count() < result.bestMs) {
+			result.bestMs = elapsed.count();
+		}
+	}
+	result.averageMs = total / iterations;
+
+	return result;
+}
+
+static void WriteJson(std::ostream& out, BenchConfig* config, std::vector<BenchResult>* results) {
+	out << "{\n";
+	out << "  \"benchmark\": \"database\",\n";
+	out << "  \"config\": { \"writes\": " << config->writes << ", \"size\": " << config->size << ", \"iterations\": " << config->iterations << " },\n";
+	out << "  \"results\": [\n";
+	for (size_t i = 0; i < results->size(); i++) {
+		auto & result = (*results)[i];
+		double itemsPerSecond = result.bestMs > 0 ? result.items / (result.bestMs / 1000.0) : 0;
+
+		out << "    { \"name\": \"" << result.name << "\"";
+		out << ", \"best_ms\": " << result.bestMs;
+		out << ", \"average_ms\": " << result.averageMs;
+		out << ", \"items\": " << result.items;
+		out << ", \"items_per_second\": " << itemsPerSecond;
+		out << " }" << (i + 1 < results->size() ? "," : "") << "\n";
+	}
+	out << "  ]\n";
+	out << "}" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	BenchConfig config;
+	if (!ParseArguments(argc, argv, &config)) {
+		return 1;
+	}
+
+	auto fileName = (std::filesystem::temp_directory_path() / "pretty_bench.db").string();
+	for (auto suffix: { "", "-wal", "-shm" }) {
+		std::remove((fileName + suffix).c_str());
+	}
+
+	std::vector<BenchResult> results;
+	const std::string text(config.size, 'x');
+
+	{
+		PrettyEngine::DataBase dataBase(fileName);
+		SetupDataBase(&dataBase);
+
+		// Each write is its own transaction, but with synchronous=NORMAL a WAL commit does not sync the disk.
+		results.push_back(Measure("autocommit_writes", config.iterations, config.writes, [&]{
+			Write(&dataBase, &config, text);
+		}));
+
+		// Syncing every commit is what makes autocommit expensive.
+		dataBase.SetSynchronous(PrettyEngine::SynchronousLevel::Full);
+		results.push_back(Measure("autocommit_writes_full_sync", config.iterations, config.writes, [&]{
+			Write(&dataBase, &config, text);
+		}));
+		dataBase.SetSynchronous(PrettyEngine::SynchronousLevel::Normal);
+
+		results.push_back(Measure("batched_writes", config.iterations, config.writes, [&]{
+			PrettyEngine::SQLTransaction transaction(&dataBase);
+			Write(&dataBase, &config, text);
+			transaction.Commit();
+		}));
+	}
+
+	for (auto suffix: { "", "-wal", "-shm" }) {
+		std::remove((fileName + suffix).c_str());
+	}
+
+	if (config.output.empty()) {
+		WriteJson(std::cout, &config, &results);
+	} else {
+		std::ofstream out(config.output);
+		WriteJson(out, &config, &results);
+	}
+
+	return 0;
+}
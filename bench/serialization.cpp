@@ -0,0 +1,318 @@
+/*
+ * Serialization benchmark, generate a synthetic world and print the results as JSON.
+ * Each result has the heap high-water mark of its phase, the process peak resident memory is reported once.
+ * Usage: bench_serialization [--entities N] [--components N] [--fields N] [--iterations N] [--output file.json]
+*/
+
+#include <PrettyEngine/worldLoad.hpp>
+#include <PrettyEngine/serial.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+struct BenchConfig {
+	size_t entities = 1000;
+	size_t components = 2;
+	size_t fields = 8;
+	size_t iterations = 5;
+	std::string output;
+};
+
+struct BenchResult {
+	std::string name;
+	double bestMs = 0;
+	double averageMs = 0;
+	size_t items = 0;
+	size_t bytes = 0;
+	/// Highest heap usage reached during the phase, above the usage at its start.
+	size_t peakHeapBytes = 0;
+};
+
+/// Heap usage tracked by the global allocation operators, so each phase get its own high-water mark.
+static std::atomic<size_t> liveHeapBytes = 0;
+static std::atomic<size_t> peakHeapBytes = 0;
+
+/// Keep the size of each block in front of it, aligned like malloc.
+static constexpr size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+static void* TrackedAllocate(size_t size) {
+	auto block = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER));
+	if (block == nullptr) {
+		return nullptr;
+	}
+	*reinterpret_cast<size_t*>(block) = size;
+
+	auto live = liveHeapBytes.fetch_add(size) + size;
+	auto peak = peakHeapBytes.load();
+	while (live > peak && !peakHeapBytes.compare_exchange_weak(peak, live)) {}
+
+	return block + ALLOCATION_HEADER;
+}
+
+static void TrackedFree(void* pointer) {
+	if (pointer == nullptr) {
+		return;
+	}
+	auto block = static_cast<char*>(pointer) - ALLOCATION_HEADER;
+	liveHeapBytes.fetch_sub(*reinterpret_cast<size_t*>(block));
+	std::free(block);
+}
+
+void* operator new(size_t size) {
+	if (auto pointer = TrackedAllocate(size)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return TrackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return TrackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { TrackedFree(pointer); }
+
+/// Peak resident memory of the process in bytes.
+static size_t GetPeakMemory() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	#if defined(__APPLE__)
+		return usage.ru_maxrss;
+	#else
+		return usage.ru_maxrss * 1024;
+	#endif
+#endif
+}
+
+static bool ParseArguments(int argc, char** argv, BenchConfig* config) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (i + 1 >= argc) {
+			std::cerr << "Missing value for: " << argument << std::endl;
+			return false;
+		}
+
+		std::string value = argv[++i];
+		if (argument == "--entities") {
+			config->entities = std::stoull(value);
+		} else if (argument == "--components") {
+			config->components = std::stoull(value);
+		} else if (argument == "--fields") {
+			config->fields = std::stoull(value);
+		} else if (argument == "--iterations") {
+			config->iterations = std::max<size_t>(1, std::stoull(value));
+		} else if (argument == "--output") {
+			config->output = value;
+		} else {
+			std::cerr << "Unknown argument: " << argument << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+static void AddSyntheticFields(PrettyEngine::SerialObject* object, size_t count, size_t seed) {
+	for (size_t i = 0; i < count; i++) {
+		auto value = std::to_string(seed * 31 + i);
+		object->AddSerializedField(i % 2 == 0 ? SERIAL_TOKEN(int) : SERIAL_TOKEN(std::string), "Field" + std::to_string(i), value);
+	}
+}
+
+static void GenerateWorld(PrettyEngine::World* world, BenchConfig* config) {
+	for (size_t i = 0; i < config->entities; i++) {
+		auto entity = CreateCustomEntity("Empty");
+		world->RegisterEntity(entity);
+
+		entity->serialObjectName = "Empty";
+		entity->serialObjectUnique = entity->GetGUID();
+		entity->entityName = "Entity" + std::to_string(i);
+		entity->position = glm::vec3(i, i * 2.0f, 0.0f);
+		AddSyntheticFields(entity.get(), config->fields, i);
+
+		for (size_t c = 0; c < config->components; c++) {
+			auto component = GetCustomComponent("Light");
+			component->serialObjectName = "Light";
+			component->owner = entity.get();
+			component->OnSetup();
+			AddSyntheticFields(component.get(), config->fields, i + c);
+			entity->components.push_back(component);
+		}
+	}
+}
+
+/// Every serializable object of the world, entities and components.
+static std::vector<PrettyEngine::SerialObject*> CollectObjects(PrettyEngine::World* world) {
+	std::vector<PrettyEngine::SerialObject*> result;
+	for (auto & entity: world->entities) {
+		result.push_back(entity.second.get());
+		for (auto & component: entity.second->components) {
+			result.push_back(component.get());
+		}
+	}
+	return result;
+}
+
+template<typename Function>
+static BenchResult Measure(std::string name, size_t iterations, size_t items, Function function) {
+	BenchResult result;
+	result.name = name;
+	result.items = items;
+
+	auto baseline = liveHeapBytes.load();
+	peakHeapBytes = baseline;
+
+	double total = 0;
+	for (size_t i = 0; i < iterations; i++) {
+		auto start = std::chrono::steady_clock::now();
+		result.bytes = function();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		total += elapsed.count();
+		if (i == 0 || elapsed.count() < result.bestMs) {
+			result.bestMs = elapsed.count();
+		}
+	}
+	result.averageMs = total / iterations;
+	result.peakHeapBytes = peakHeapBytes.load() - baseline;
+
+	return result;
+}
+
+static BenchResult MeasureSerialize(std::string name, std::vector<PrettyEngine::SerialObject*>* objects, PrettyEngine::SerializationFormat format, size_t iterations, std::vector<std::string>* out) {
+	return Measure(name, iterations, objects->size(), [objects, format, out]{
+		out->clear();
+		size_t bytes = 0;
+		for (auto & object: *objects) {
+			out->push_back(object->Serialize(format));
+			bytes += out->back().size();
+		}
+		return bytes;
+	});
+}
+
+static BenchResult MeasureDeserialize(std::string name, std::vector<std::string>* inputs, PrettyEngine::SerializationFormat format, size_t iterations) {
+	return Measure(name, iterations, inputs->size(), [inputs, format]{
+		size_t bytes = 0;
+		for (auto & input: *inputs) {
+			PrettyEngine::SerialObject object;
+			object.Deserialize(input, format);
+			bytes += input.size();
+		}
+		return bytes;
+	});
+}
+
+static void WriteJson(std::ostream& out, BenchConfig* config, std::vector<BenchResult>* results, size_t peakMemory) {
+	out << "{\n";
+	out << "  \"benchmark\": \"serialization\",\n";
+	out << "  \"config\": { \"entities\": " << config->entities << ", \"components\": " << config->components << ", \"fields\": " << config->fields << ", \"iterations\": " << config->iterations << " },\n";
+	out << "  \"peak_memory_bytes\": " << peakMemory << ",\n";
+	out << "  \"results\": [\n";
+	for (size_t i = 0; i < results->size(); i++) {
+		auto & result = (*results)[i];
+		double itemsPerSecond = result.bestMs > 0 ? result.items / (result.bestMs / 1000.0) : 0;
+		double bytesPerSecond = result.bestMs > 0 ? result.bytes / (result.bestMs / 1000.0) : 0;
+
+		out << "    { \"name\": \"" << result.name << "\"";
+		out << ", \"best_ms\": " << result.bestMs;
+		out << ", \"average_ms\": " << result.averageMs;
+		out << ", \"items\": " << result.items;
+		out << ", \"bytes\": " << result.bytes;
+		out << ", \"peak_heap_bytes\": " << result.peakHeapBytes;
+		out << ", \"items_per_second\": " << itemsPerSecond;
+		out << ", \"bytes_per_second\": " << bytesPerSecond;
+		out << " }" << (i + 1 < results->size() ? "," : "") << "\n";
+	}
+	out << "  ]\n";
+	out << "}" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	BenchConfig config;
+	if (!ParseArguments(argc, argv, &config)) {
+		return 1;
+	}
+
+	std::vector<BenchResult> results;
+
+	auto worldPath = (std::filesystem::temp_directory_path() / "pretty_bench_world.toml").string();
+	std::ofstream(worldPath).close();
+
+	{
+		auto world = std::make_shared<PrettyEngine::World>(worldPath);
+		GenerateWorld(world.get(), &config);
+
+		auto objects = CollectObjects(world.get());
+		std::vector<std::string> serialized;
+
+		results.push_back(MeasureSerialize("serialize_toml", &objects, PrettyEngine::SerializationFormat::Toml, config.iterations, &serialized));
+		results.push_back(MeasureDeserialize("deserialize_toml", &serialized, PrettyEngine::SerializationFormat::Toml, config.iterations));
+
+		results.push_back(MeasureSerialize("serialize_binary", &objects, PrettyEngine::SerializationFormat::Binary, config.iterations, &serialized));
+		results.push_back(MeasureDeserialize("deserialize_binary", &serialized, PrettyEngine::SerializationFormat::Binary, config.iterations));
+
+		results.push_back(Measure("world_save", config.iterations, world->entities.size(), [&world, &worldPath]{
+			world->Save();
+			return static_cast<size_t>(std::filesystem::file_size(worldPath));
+		}));
+	}
+
+	{
+		auto world = std::make_shared<PrettyEngine::World>(worldPath);
+		results.push_back(Measure("world_load", config.iterations, config.entities, [&world, &worldPath]{
+			world->Load();
+			return static_cast<size_t>(std::filesystem::file_size(worldPath));
+		}));
+	}
+
+	std::filesystem::remove(worldPath);
+	std::filesystem::remove(worldPath + ".meta");
+
+	auto peakMemory = GetPeakMemory();
+
+	if (config.output.empty()) {
+		WriteJson(std::cout, &config, &results, peakMemory);
+	} else {
+		std::ofstream out(config.output);
+		WriteJson(out, &config, &results, peakMemory);
+	}
+
+	return 0;
+}
@@ -4,6 +4,7 @@
 #include <PrettyEngine/KeyCode.hpp>
 #include <Physical.hpp>
 #include <PrettyEngine/serial.hpp>
+#include <PrettyEngine/schema.hpp>
 #include <PrettyEngine/entity.hpp>
 
 #include <string>
@@ -13,9 +14,15 @@ using namespace PrettyEngine;
 namespace Custom {
 	class BaseCharacterController: public virtual Component {
 	public:
+		static const SerialSchema* GetSchema() {
+			static const SerialSchema schema = SerialSchema(1)
+				.Field(SERIAL_TOKEN(std::string), "colliderName", "Collider")
+				.Field(SERIAL_TOKEN(float), "speed", "100");
+			return &schema;
+		}
+
 		void OnSetup() override {
-			this->AddSerializedField(SERIAL_TOKEN(std::string), "colliderName", "Collider");
-			this->AddSerializedField(SERIAL_TOKEN(float), "speed", "100");
+			GetSchema()->Apply(this);
 		}
 
 		void OnPrePhysics() override {
@@ -3,6 +3,7 @@
 #include <PrettyEngine/entity.hpp>
 #include <PrettyEngine/render/light.hpp>
 #include <PrettyEngine/localization.hpp>
+#include <PrettyEngine/schema.hpp>
 
 #include <Guid.hpp>
 #include <string>
@@ -10,15 +11,21 @@
 namespace Custom {
 	class Light: public PrettyEngine::Component {
 	public:
+		static const PrettyEngine::SerialSchema* GetSchema() {
+			static const PrettyEngine::SerialSchema schema = PrettyEngine::SerialSchema(1)
+				.Field(SERIAL_TOKEN(glm::vec3), "Color", "0;0;0")
+				.Field(SERIAL_TOKEN(float), "LightFactor", "0")
+				.Field(SERIAL_TOKEN(float), "DeferredFactor", "0")
+				.Field(SERIAL_TOKEN(int), "LightLayer", "0")
+				.Field(SERIAL_TOKEN(float), "Radius", "0")
+				.Field(SERIAL_TOKEN(PrettyEngine::LightType), "Type", "point")
+				.Field(SERIAL_TOKEN(float), "SpotLightCutOff", "0")
+				.Field(SERIAL_TOKEN(glm::vec4), "SpotDirection", "0;0;0;0");
+			return &schema;
+		}
+
 		void OnSetup() override {
-			this->AddSerializedField(SERIAL_TOKEN(glm::vec3), "Color", "0;0;0");
-			this->AddSerializedField(SERIAL_TOKEN(float), "LightFactor", "0");
-			this->AddSerializedField(SERIAL_TOKEN(float), "DeferredFactor", "0");
-			this->AddSerializedField(SERIAL_TOKEN(int), "LightLayer", "0");
-			this->AddSerializedField(SERIAL_TOKEN(float), "Radius", "0");
-			this->AddSerializedField(SERIAL_TOKEN(PrettyEngine::LightType), "Type", "point");
-			this->AddSerializedField(SERIAL_TOKEN(float), "SpotLightCutOff", "0");
-			this->AddSerializedField(SERIAL_TOKEN(glm::vec4), "SpotDirection", "0;0;0;0");
+			GetSchema()->Apply(this);
 		}
 
 		void OnStart() override {
@@ -35,6 +35,11 @@ namespace Custom {
 						CreateFile(path);
 					}
 					
+					if (this->currentLocalization != nullptr && this->engineContent != nullptr && this->engineContent->fileWatcher.Changed(this->currentLocalization->GetFilePath())) {
+						DebugLog(LOG_DEBUG, "Reload changed localization: " << this->currentLocalization->GetFilePath(), false);
+						this->currentLocalization->Reload();
+					}
+
 					if (this->currentLocalization != nullptr) {
 						for(auto & index: this->localizationsToRemove) {
 							DebugLog(LOG_DEBUG, "To Remove: " << index, false);
@@ -6,12 +6,24 @@
 #include <PrettyEngine/debug/debug.hpp>
 #include <PrettyEngine/localization.hpp>
 #include <PrettyEngine/render/mesh.hpp>
+#include <PrettyEngine/schema.hpp>
 
 #include <Guid.hpp>
 
 namespace Custom {
 	class Physical: public PrettyEngine::Component {
 	public:
+		static const PrettyEngine::SerialSchema* GetSchema() {
+			static const PrettyEngine::SerialSchema schema = PrettyEngine::SerialSchema(1)
+				.Field(SERIAL_TOKEN(bool), "rigidbody", SERIAL_TOKEN(false))
+				.Field(SERIAL_TOKEN(std::string), "layer", "Default")
+				.Field(SERIAL_TOKEN(std::string), "name", []{ return xg::newGuid().str(); })
+				.Field(SERIAL_TOKEN(float), "mass", "1")
+				.Field(SERIAL_TOKEN(bool), "fixed", "false")
+				.Field(SERIAL_TOKEN(glm::vec3), "Gravity", "0;9.81;0");
+			return &schema;
+		}
+
 		void OnSetup() override {
 			this->publicFuncions.insert(std::make_pair("Update gravity", ([this]() {
 				auto gravity = PrettyEngine::ParseCSVLine(this->GetSerializedFieldValue("Gravity"), ';');
@@ -23,12 +35,7 @@ namespace Custom {
 				}
 			})));
 
-			this->AddSerializedField(SERIAL_TOKEN(bool), "rigidbody", SERIAL_TOKEN(false));
-			this->AddSerializedField(SERIAL_TOKEN(std::string), "layer", "Default");
-			this->AddSerializedField(SERIAL_TOKEN(std::string), "name", xg::newGuid());
-			this->AddSerializedField(SERIAL_TOKEN(float), "mass", "1");
-			this->AddSerializedField(SERIAL_TOKEN(bool), "fixed", "false");
-			this->AddSerializedField(SERIAL_TOKEN(glm::vec3), "Gravity", "0;9.81;0");
+			GetSchema()->Apply(this);
 
 			if (this->GetSerializedFieldValue("fixed") == "false") {
 				this->_colliderA.fixed = false;
@@ -83,6 +90,6 @@ namespace Custom {
 
 		PrettyEngine::Entity* _ownerEntity = nullptr;
 
-		std::string layer;
+		PrettyEngine::InternedString layer;
 	};
 }
@@ -8,6 +8,9 @@
 #include <PrettyEngine/shaders.hpp>
 #include <PrettyEngine/render/visualObject.hpp>
 #include <PrettyEngine/assetManager.hpp>
+#include <PrettyEngine/assetCache.hpp>
+#include <PrettyEngine/cooked.hpp>
+#include <PrettyEngine/schema.hpp>
 
 #include <memory>
 
@@ -16,28 +19,35 @@ using namespace PrettyEngine;
 namespace Custom {
 class Render : public PrettyEngine::Component {
 public:
-	void OnSetup() override {
-		
-		this->AddSerializedField(SERIAL_TOKEN(bool), "UseTexure", SERIAL_TOKEN(false));
-
-	    this->AddSerializedField(SERIAL_TOKEN(bool), "UseTextureBase", SERIAL_TOKEN(false));
-		this->AddSerializedField(SERIAL_TOKEN(std::string), "TextureBase", "");
-
-	    this->AddSerializedField(SERIAL_TOKEN(bool), "UseTextureTransparency", SERIAL_TOKEN(false));
-		this->AddSerializedField(SERIAL_TOKEN(std::string), "TextureTransparency", "");
-
-	    this->AddSerializedField(SERIAL_TOKEN(bool), "UseTextureNormal", SERIAL_TOKEN(false));
-		this->AddSerializedField(SERIAL_TOKEN(std::string), "TextureNormal", "");
-
-	    this->AddSerializedField(SERIAL_TOKEN(PrettyEngine::Mesh), "Mesh", "");
-		this->AddSerializedField(SERIAL_TOKEN(std::string), "MeshGUID", xg::newGuid());
-		this->AddSerializedField(SERIAL_TOKEN(bool), "UseLight", SERIAL_TOKEN(false));
-		this->AddSerializedField(SERIAL_TOKEN(bool), "SunLight", SERIAL_TOKEN(false));
-		this->AddSerializedField(SERIAL_TOKEN(bool), "ScreenObject", SERIAL_TOKEN(false));
-
-		this->AddSerializedField(SERIAL_TOKEN(glm::vec4), "Color", "1;1;1;1");
+	static const PrettyEngine::SerialSchema* GetSchema() {
+		static const PrettyEngine::SerialSchema schema = PrettyEngine::SerialSchema(2)
+			.Field(SERIAL_TOKEN(bool), "UseTexture", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(bool), "UseTextureBase", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(std::string), "TextureBase", "")
+			.Field(SERIAL_TOKEN(bool), "UseTextureTransparency", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(std::string), "TextureTransparency", "")
+			.Field(SERIAL_TOKEN(bool), "UseTextureNormal", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(std::string), "TextureNormal", "")
+			.Field(SERIAL_TOKEN(PrettyEngine::Mesh), "Mesh", "")
+			.Field(SERIAL_TOKEN(std::string), "MeshGUID", []{ return std::string(xg::newGuid()); })
+			.Field(SERIAL_TOKEN(bool), "UseLight", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(bool), "SunLight", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(bool), "ScreenObject", SERIAL_TOKEN(false))
+			.Field(SERIAL_TOKEN(glm::vec4), "Color", "1;1;1;1")
+			.Field(SERIAL_TOKEN(bool), "WireFrame", SERIAL_TOKEN(false))
+			// Drawn by the sprite batch of the renderer, only the base texture and the color are used.
+			.Field(SERIAL_TOKEN(bool), "Batched", SERIAL_TOKEN(false))
+			// Before schemas the field was saved with a typo and never read back.
+			.Migration(0, [](PrettyEngine::SerialObject* object) {
+				if (!object->RenameSerializedField("UseTexure", "UseTexture")) {
+					object->RemoveSerializedField("UseTexure");
+				}
+			});
+		return &schema;
+	}
 
-		this->AddSerializedField(SERIAL_TOKEN(bool), "WireFrame", SERIAL_TOKEN(false));
+	void OnSetup() override {
+		GetSchema()->Apply(this);
 	}
 
 	void OnEditorStart() override {
@@ -59,14 +69,14 @@ public:
 
 	void RefreshTextureBase() {
 		if (this->GetSerializedFieldValue("UseTextureBase") == "true") {
-			const auto texturePath = GetEnginePublicPath(this->GetSerializedFieldValue("TextureBase"), true);
-			this->baseTexture = Asset(texturePath);
+			const auto texturePath = FindCookedAsset(this->GetSerializedFieldValue("TextureBase"), ".ptex");
+			this->baseTexture = this->engineContent->assetCache.Acquire(texturePath);
 
-			if (this->baseTexture.Exist() && this->visualObject != nullptr) {
+			if (this->baseTexture->Exist() && this->visualObject != nullptr) {
 				if (this->visualObject->HaveTexture(TextureType::Base)) {
 					this->visualObject->RemoveTexture(TextureType::Base);
 				}
-				this->texture = this->engineContent->renderer.AddTexture(texturePath, &this->baseTexture, TextureType::Base, TextureWrap::ClampToBorder, TextureFilter::Linear, TextureChannels::RGBA);
+				this->texture = this->engineContent->renderer.AddTextureAsync(texturePath, this->baseTexture, TextureType::Base, TextureWrap::ClampToBorder, TextureFilter::Linear, TextureChannels::RGBA);
 				this->visualObject->AddTexture(this->texture);
 			}
 		}
@@ -74,14 +84,14 @@ public:
 
 	void RefreshTextureTransparency() {
 		if (this->GetSerializedFieldValue("UseTextureTransparency") == "true") {
-			const auto texturePath = GetEnginePublicPath(this->GetSerializedFieldValue("TextureTransparency"), true);
-			this->transparencyTexture = Asset(texturePath);
+			const auto texturePath = FindCookedAsset(this->GetSerializedFieldValue("TextureTransparency"), ".ptex");
+			this->transparencyTexture = this->engineContent->assetCache.Acquire(texturePath);
 
-			if (this->transparencyTexture.Exist() && this->visualObject != nullptr) {
+			if (this->transparencyTexture->Exist() && this->visualObject != nullptr) {
 				if (this->visualObject->HaveTexture(TextureType::Transparency)) {
 					this->visualObject->RemoveTexture(TextureType::Transparency);
 				}
-				this->textureTransparency = this->engineContent->renderer.AddTexture(texturePath, &this->transparencyTexture, TextureType::Transparency, TextureWrap::ClampToBorder, TextureFilter::Linear, TextureChannels::RGBA);
+				this->textureTransparency = this->engineContent->renderer.AddTextureAsync(texturePath, this->transparencyTexture, TextureType::Transparency, TextureWrap::ClampToBorder, TextureFilter::Linear, TextureChannels::RGBA);
 				this->visualObject->AddTexture(this->textureTransparency);
 			}
 		}
@@ -89,14 +99,14 @@ public:
 
 	void RefreshTextureNormal() {
 		if (this->GetSerializedFieldValue("UseTextureNormal") == "true") {
-			const auto texturePath = GetEnginePublicPath(this->GetSerializedFieldValue("TextureTransparency"), true);
-			this->normalTexture = Asset(texturePath);
+			const auto texturePath = FindCookedAsset(this->GetSerializedFieldValue("TextureNormal"), ".ptex");
+			this->normalTexture = this->engineContent->assetCache.Acquire(texturePath);
 
-			if (this->normalTexture.Exist() && this->visualObject != nullptr) {
+			if (this->normalTexture->Exist() && this->visualObject != nullptr) {
 				if (this->visualObject->HaveTexture(TextureType::Normal)) {
 					this->visualObject->RemoveTexture(TextureType::Normal);
 				}
-				this->textureNormal = this->engineContent->renderer.AddTexture(texturePath, &this->normalTexture, TextureType::Normal, TextureWrap::ClampToBorder, TextureFilter::Linear, TextureChannels::RGBA);
+				this->textureNormal = this->engineContent->renderer.AddTextureAsync(texturePath, this->normalTexture, TextureType::Normal, TextureWrap::ClampToBorder, TextureFilter::Linear, TextureChannels::RGBA);
 				this->visualObject->AddTexture(this->textureNormal);
 			}
 		}
@@ -114,7 +124,7 @@ public:
 		this->visualObject->baseColor.b = std::stof(color[2]);
 		this->visualObject->opacity = std::stof(color[3]);
 
-		// The mesh GUID is for now locked at this value, because mesh loading is not supported 
+		// Meshes are shared by name, the rect or the path of a cooked mesh
 	    this->meshGuid = "rect"; // this->GetSerializedFieldValue("MeshGUID");
 
 	    this->visualObject->useLight = (this->GetSerializedFieldValue("UseLight") == "true");
@@ -140,17 +150,30 @@ public:
 
 	    bool loadMesh = false;
 
-		const auto meshPath = GetEnginePublicPath(this->GetPublicVarValue("Mesh"), true);
+		const auto meshPath = this->GetPublicVarValue("Mesh");
 		// Check if the mesh is already loaded
 		if (this->mesh == nullptr) {
 			this->renderModel.RemoveMesh();
-			const auto newMesh = CreateRectMesh();
+
+			// Only cooked meshes can be loaded, the rect is kept until the mesh is cooked
+			Mesh newMesh;
+			if (!meshPath.empty() && LoadCookedMeshAsset(meshPath, &newMesh)) {
+				this->meshGuid = meshPath;
+			} else {
+				newMesh = CreateRectMesh();
+			}
+
 			this->mesh = this->engineContent->renderer.AddMesh(meshGuid, newMesh);
 			this->renderModel.SetMesh(this->mesh);
 			loadMesh = true;
 		}
 
-	    if (loadMesh) {
+	    const bool wasBatched = this->batched;
+	    this->batched = (this->GetSerializedFieldValue("Batched") == "true");
+
+	    if (this->batched) {
+	    	this->engineContent->renderer.UnRegisterVisualObject(visualObjectGuid);
+	    } else if (loadMesh || wasBatched) {
 	      	this->engineContent->renderer.UnRegisterVisualObject(visualObjectGuid);
 	      	this->engineContent->renderer.RegisterVisualObject(visualObjectGuid, this->visualObject);
 	    }
@@ -160,6 +183,14 @@ public:
 	    this->Init();
   	}
 
+	void CollectAssetDependencies(std::vector<std::string>* out) override {
+		for (auto & texture: { "TextureBase", "TextureTransparency", "TextureNormal" }) {
+			if (this->GetSerializedFieldValue(std::string("Use") + texture) == "true" && !this->GetSerializedFieldValue(texture).empty()) {
+				out->push_back(this->GetSerializedFieldValue(texture));
+			}
+		}
+	}
+
   	void OnDestroy() override {
     	this->engineContent->renderer.UnRegisterVisualObject(visualObjectGuid);
   	}
@@ -168,12 +199,24 @@ public:
   		this->visualObject->position = dynamic_cast<Entity *>(this->owner)->position;
 	    this->visualObject->rotation = dynamic_cast<Entity *>(this->owner)->rotation;
 	    this->visualObject->scale = dynamic_cast<Entity *>(this->owner)->scale;
+
+	    if (this->batched && this->visualObject->active) {
+	    	const bool useTexture = this->renderModel.useTexture && this->texture != nullptr;
+	    	this->engineContent->renderer.spriteBatch.Draw(
+	    		useTexture ? this->texture->textureID : 0,
+	    		this->visualObject->GetTransformMatrix(),
+	    		glm::vec4(this->visualObject->baseColor, this->visualObject->opacity),
+	    		this->visualObject->renderLayer,
+	    		this->visualObject->screenObject
+	    	);
+	    }
   	}
 
   	VisualObject *GetVisualObject() const { return this->visualObject.get(); }
 
 private:
   	Mesh *mesh = nullptr;
+  	bool batched = false;
   	std::string meshGuid = xg::newGuid();
   	Texture *texture = nullptr;
   	Texture *textureTransparency = nullptr;
@@ -183,9 +226,9 @@ private:
   	std::shared_ptr<VisualObject> visualObject = std::make_shared<VisualObject>();
   	std::string visualObjectGuid = xg::newGuid();
 
-	Asset baseTexture;
-	Asset transparencyTexture;
-	Asset normalTexture;
+	AssetHandle baseTexture;
+	AssetHandle transparencyTexture;
+	AssetHandle normalTexture;
 };
 } // namespace Custom
 
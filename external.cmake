@@ -76,6 +76,34 @@ set(BUILD_SHARED_LIBS OFF)
 set(ZLIB_LIBRARY "${CMAKE_SOURCE_DIR}/external/zlib")
 set(ZLIB_INCLUDE_DIR "${CMAKE_SOURCE_DIR}/external/zlib")
 
+project(zlib C)
+
+message("-- ZLib")
+# The CMakeLists of zlib renames the tracked zconf.h on out of source builds, the library is built from its sources with that header instead.
+add_library(zlibstatic STATIC
+	"${CMAKE_SOURCE_DIR}/external/zlib/adler32.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/compress.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/crc32.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/deflate.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/gzclose.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/gzlib.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/gzread.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/gzwrite.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/inflate.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/infback.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/inftrees.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/inffast.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/trees.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/uncompr.c"
+	"${CMAKE_SOURCE_DIR}/external/zlib/zutil.c"
+)
+
+if(MSVC)
+	target_compile_definitions(zlibstatic PRIVATE _CRT_SECURE_NO_DEPRECATE _CRT_NONSTDC_NO_DEPRECATE)
+endif()
+
+include_directories("${CMAKE_SOURCE_DIR}/external/zlib")
+
 message("-- OpenAL")
 # Set CMake options to control OpenAL Soft features
 option(ALSOFT_UTILS "Build utility programs" OFF)
@@ -109,4 +137,5 @@ target_link_libraries(external PUBLIC
  	OpenAL
  	sqlite3
  	implot
+ 	zlibstatic
 )
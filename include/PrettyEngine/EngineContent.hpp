@@ -6,16 +6,21 @@
 #include <PrettyEngine/PhysicalSpace.hpp>
 #include <PrettyEngine/Input.hpp>
 #include <PrettyEngine/event.hpp>
+#include <PrettyEngine/assetCache.hpp>
+#include <PrettyEngine/fileWatcher.hpp>
 
 namespace PrettyEngine {
 	/// Contain all the sub-engines and systems shared by the Engine.
 	class EngineContent {
 	public:
+		/// First so it is destroyed after the systems holding asset handles.
+		AssetCache assetCache = AssetCache();
 		Renderer renderer = Renderer();
 		AudioEngine audioEngine = AudioEngine();
 		Input input = Input();
 		PhysicalSpace physicalSpace = PhysicalSpace();
 		EventManager eventManager = EventManager();
+		FileWatcher fileWatcher;
 	};
 }
 
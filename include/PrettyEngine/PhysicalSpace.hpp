@@ -16,12 +16,12 @@ namespace PrettyEngine {
 	/// Physics engine and so manage the PhysicalObjects.
 	class PhysicalSpace {
 	public:
-		void AddCollider(std::string layerName, Collider* collider) {
+		void AddCollider(InternedString layerName, Collider* collider) {
 			auto layer = this->GetOrCreateLayer(layerName);
 			layer->push_back(collider);
 		}
 
-		bool RemoveCollider(std::string layerName, Collider* collider) {
+		bool RemoveCollider(InternedString layerName, Collider* collider) {
 			auto layer = this->GetOrCreateLayer(layerName);
 			size_t index = 0;
 			for(auto & i: *layer) {
@@ -34,16 +34,10 @@ namespace PrettyEngine {
 			return false;
 		}
 
-		std::unordered_map<std::string, std::vector<Collider*>>* GetAllLayers() { return &this->_colliders;}
+		std::unordered_map<InternedString, std::vector<Collider*>>* GetAllLayers() { return &this->_colliders;}
 
-		std::vector<Collider*>* GetOrCreateLayer(std::string layerName) {
-			for(auto & layer: this->_colliders) {
-				if (layer.first == layerName) {
-					return &layer.second;
-				}
-			}
-			this->_colliders.insert_or_assign(layerName, std::vector<Collider*>());
-			return GetOrCreateLayer(layerName);
+		std::vector<Collider*>* GetOrCreateLayer(InternedString layerName) {
+			return &this->_colliders[layerName];
 		}
 
 		std::vector<Collider*>* FindColliderLayer(Collider* collider) {
@@ -135,7 +129,7 @@ namespace PrettyEngine {
   		}
 
 	private:
-		std::unordered_map<std::string, std::vector<Collider*>> _colliders;
+		std::unordered_map<InternedString, std::vector<Collider*>> _colliders;
 
 		std::unordered_map<Collider*, std::vector<Collision>> _collisions;
 	};
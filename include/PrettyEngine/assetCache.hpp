@@ -0,0 +1,322 @@
+#ifndef HPP_ASSET_CACHE
+#define HPP_ASSET_CACHE
+
+#include <PrettyEngine/assetManager.hpp>
+#include <PrettyEngine/vfs.hpp>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PrettyEngine {
+	class AssetCache;
+
+	struct AssetCacheEntry {
+	public:
+		std::string path;
+		/// Created by the first Acquire, outside the lock of the cache.
+		std::unique_ptr<Asset> asset;
+		VirtualFile data;
+		/// Outdated data still viewed by the holders of a handle, released with the last reference.
+		std::vector<VirtualFile> retired;
+		size_t referenceCount = 0;
+		/// Held while the asset is created and while its data are loaded, so each is done once while the other assets can be loaded at the same time.
+		std::mutex loadMutex;
+		/// Position in the list of unreferenced entries, valid only when referenceCount is 0.
+		std::list<AssetCacheEntry*>::iterator unusedPosition;
+	};
+
+	struct AssetCacheStats {
+	public:
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t entries = 0;
+		size_t loadedBytes = 0;
+		size_t budget = 0;
+	};
+
+	/// Reference to an asset of an AssetCache, the asset stay in memory while at least one handle exist.
+	class AssetHandle {
+	public:
+		AssetHandle() = default;
+
+		AssetHandle(AssetCache* newCache, AssetCacheEntry* newEntry) {
+			this->_cache = newCache;
+			this->_entry = newEntry;
+		}
+
+		AssetHandle(const AssetHandle& other) { this->Copy(other); }
+
+		AssetHandle(AssetHandle&& other) noexcept {
+			this->_cache = other._cache;
+			this->_entry = other._entry;
+			other._cache = nullptr;
+			other._entry = nullptr;
+		}
+
+		AssetHandle& operator=(const AssetHandle& other) {
+			if (this != &other) {
+				this->Reset();
+				this->Copy(other);
+			}
+			return *this;
+		}
+
+		AssetHandle& operator=(AssetHandle&& other) noexcept {
+			if (this != &other) {
+				this->Reset();
+				this->_cache = other._cache;
+				this->_entry = other._entry;
+				other._cache = nullptr;
+				other._entry = nullptr;
+			}
+			return *this;
+		}
+
+		~AssetHandle() { this->Reset(); }
+
+		void Reset();
+
+		bool Valid() const { return this->_entry != nullptr; }
+
+		Asset* Get() const { return this->_entry != nullptr ? this->_entry->asset.get() : nullptr; }
+
+		Asset* operator->() const { return this->Get(); }
+
+		/// Content of the file, loaded on the first call and kept until the asset is evicted.
+		std::span<const unsigned char> GetData();
+
+	private:
+		void Copy(const AssetHandle& other);
+
+	private:
+		AssetCache* _cache = nullptr;
+		AssetCacheEntry* _entry = nullptr;
+	};
+
+	/// Load each asset once and share it, the data of unreferenced assets are evicted least recently used first when the budget is exceeded.
+	/// The cache must outlive every handle it gave.
+	class AssetCache {
+	public:
+		AssetCache(size_t newBudget = 256 * 1024 * 1024) {
+			this->_budget = newBudget;
+		}
+
+		AssetHandle Acquire(const std::string& path) {
+			AssetCacheEntry* result = nullptr;
+			{
+				std::lock_guard lock(this->_mutex);
+
+				auto found = this->_entries.find(path);
+				if (found != this->_entries.end()) {
+					this->_hits++;
+					result = found->second.get();
+					this->AddReference(result);
+					if (result->asset != nullptr) {
+						return AssetHandle(this, result);
+					}
+				} else {
+					this->_misses++;
+
+					auto entry = std::make_unique<AssetCacheEntry>();
+					entry->path = path;
+
+					result = entry.get();
+					this->_entries.insert_or_assign(path, std::move(entry));
+					this->AddReference(result);
+				}
+			}
+
+			// The entry is only a placeholder, the meta of the asset is read from the database without blocking the whole cache.
+			this->CreateAsset(result);
+			return AssetHandle(this, result);
+		}
+
+		bool Contains(const std::string& path) {
+			std::lock_guard lock(this->_mutex);
+			return this->_entries.contains(path);
+		}
+
+		void SetBudget(size_t newBudget) {
+			std::lock_guard lock(this->_mutex);
+			this->_budget = newBudget;
+			this->Evict();
+		}
+
+		AssetCacheStats GetStats() {
+			std::lock_guard lock(this->_mutex);
+
+			AssetCacheStats stats;
+			stats.hits = this->_hits;
+			stats.misses = this->_misses;
+			stats.evictions = this->_evictions;
+			stats.entries = this->_entries.size();
+			stats.loadedBytes = this->_loadedBytes;
+			stats.budget = this->_budget;
+			return stats;
+		}
+
+		void ResetStats() {
+			std::lock_guard lock(this->_mutex);
+			this->_hits = 0;
+			this->_misses = 0;
+			this->_evictions = 0;
+		}
+
+		/// Reload the file on the next GetData, for files changed on disk.
+		/// The data already given stay valid until their handles are released.
+		void Invalidate(const std::string& path) {
+			std::lock_guard lock(this->_mutex);
+
+			auto found = this->_entries.find(path);
+			if (found == this->_entries.end()) {
+				return;
+			}
+
+			auto entry = found->second.get();
+			if (entry->referenceCount == 0) {
+				this->RemoveEntry(entry);
+				return;
+			}
+
+			if (entry->data.Valid()) {
+				this->_loadedBytes -= entry->data.GetSize();
+				entry->retired.push_back(std::move(entry->data));
+			}
+		}
+
+		/// Remove every unreferenced asset, whatever the budget.
+		void Clear() {
+			std::lock_guard lock(this->_mutex);
+			while (!this->_unused.empty()) {
+				this->RemoveEntry(this->_unused.front());
+			}
+		}
+
+	private:
+		friend class AssetHandle;
+
+		void AddReference(AssetCacheEntry* entry) {
+			if (entry->referenceCount == 0 && entry->data.Valid()) {
+				this->_unused.erase(entry->unusedPosition);
+			}
+			entry->referenceCount++;
+		}
+
+		void RemoveReference(AssetCacheEntry* entry) {
+			std::lock_guard lock(this->_mutex);
+
+			entry->referenceCount--;
+			if (entry->referenceCount > 0) {
+				return;
+			}
+
+			entry->retired.clear();
+
+			// Assets without data cost nothing to reload, only the loaded ones are kept.
+			if (!entry->data.Valid()) {
+				this->RemoveEntry(entry);
+				return;
+			}
+
+			entry->unusedPosition = this->_unused.insert(this->_unused.end(), entry);
+			this->Evict();
+		}
+
+		void CreateAsset(AssetCacheEntry* entry) {
+			std::lock_guard entryLock(entry->loadMutex);
+
+			{
+				std::lock_guard lock(this->_mutex);
+				if (entry->asset != nullptr) {
+					return;
+				}
+			}
+
+			auto asset = std::make_unique<Asset>(entry->path);
+
+			std::lock_guard lock(this->_mutex);
+			entry->asset = std::move(asset);
+		}
+
+		std::span<const unsigned char> Load(AssetCacheEntry* entry) {
+			std::lock_guard entryLock(entry->loadMutex);
+
+			{
+				std::lock_guard lock(this->_mutex);
+				if (entry->data.Valid()) {
+					return entry->data.GetData();
+				}
+			}
+
+			// The entry is referenced by the caller, it can not be removed while the file is read.
+			auto data = entry->asset->Map();
+
+			std::lock_guard lock(this->_mutex);
+			this->_loadedBytes += data.GetSize();
+			entry->data = std::move(data);
+			this->Evict();
+			return entry->data.GetData();
+		}
+
+		void Evict() {
+			while (this->_loadedBytes > this->_budget && !this->_unused.empty()) {
+				this->RemoveEntry(this->_unused.front());
+				this->_evictions++;
+			}
+		}
+
+		void RemoveEntry(AssetCacheEntry* entry) {
+			if (entry->referenceCount == 0 && entry->data.Valid()) {
+				this->_unused.erase(entry->unusedPosition);
+			}
+			this->_loadedBytes -= entry->data.GetSize();
+			this->_entries.erase(entry->path);
+		}
+
+	private:
+		std::recursive_mutex _mutex;
+
+		std::unordered_map<std::string, std::unique_ptr<AssetCacheEntry>> _entries;
+		/// Unreferenced entries with data, the least recently used first.
+		std::list<AssetCacheEntry*> _unused;
+
+		size_t _budget;
+		size_t _loadedBytes = 0;
+
+		size_t _hits = 0;
+		size_t _misses = 0;
+		size_t _evictions = 0;
+	};
+
+	inline void AssetHandle::Reset() {
+		if (this->_cache != nullptr && this->_entry != nullptr) {
+			this->_cache->RemoveReference(this->_entry);
+		}
+		this->_cache = nullptr;
+		this->_entry = nullptr;
+	}
+
+	inline void AssetHandle::Copy(const AssetHandle& other) {
+		this->_cache = other._cache;
+		this->_entry = other._entry;
+		if (this->_cache != nullptr && this->_entry != nullptr) {
+			std::lock_guard lock(this->_cache->_mutex);
+			this->_cache->AddReference(this->_entry);
+		}
+	}
+
+	inline std::span<const unsigned char> AssetHandle::GetData() {
+		if (this->_cache == nullptr || this->_entry == nullptr) {
+			return {};
+		}
+		return this->_cache->Load(this->_entry);
+	}
+}
+
+#endif
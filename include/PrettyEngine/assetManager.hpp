@@ -8,6 +8,7 @@
 #include <PrettyEngine/serial.hpp>
 #include <PrettyEngine/gc.hpp>
 #include <PrettyEngine/utils.hpp>
+#include <PrettyEngine/vfs.hpp>
 
 #include <vector>
 #include <string>
@@ -31,9 +32,20 @@ namespace PrettyEngine {
 			this->GetSerializedField("used")->value = state ? "true" : "false";
 		}
 
-		bool Exist() { return FileExist(this->GetFilePath()); }
+		/// The file may be loose, in a pack or in the database, see VirtualFileSystem.
+		bool Exist() { return VirtualFileSystem::Get()->Exists(this->GetFilePath()); }
 
-		std::vector<unsigned char> Read();
+		/// Read-only view of the file, without copy unless it is compressed, the data live as long as the returned handle.
+		/// Does not change the asset so it can be called from loading threads, use SetUsed from the thread owning the asset.
+		VirtualFile Map();
+
+		std::future<VirtualFile> MapAsync() {
+			return std::async([this]{
+				return this->Map();
+			});
+		}
+
+		std::vector<unsigned char> Read() { return this->Map().ToVector(); }
 
 		std::future<std::vector<unsigned char>> ReadAsync() {
 			return std::async([this]{
@@ -41,7 +53,7 @@ namespace PrettyEngine {
 			});
 		}
 
-		std::string ReadToString() { return ReadFileToString(this->GetFilePath()); }
+		std::string ReadToString() { return VirtualFileSystem::Get()->ReadToString(this->GetFilePath()); }
 
 		std::future<std::string> ReadToStringAsync() {
 			return std::async([this]{
@@ -49,15 +61,20 @@ namespace PrettyEngine {
 			});
 		}
 
+		/// Format used the next time the meta file is written, by default the format the meta was read with.
+		void SetMetaFormat(SerializationFormat newFormat) {
+			this->metaFormat = newFormat;
+		}
+
+		SerializationFormat GetMetaFormat() { return this->metaFormat; }
+
+		/// The meta is kept by the AssetMetaRegistry and written to the disk on the next flush.
 		~Asset() {
-			if (this->Exist() && !WriteFileString(this->GetMetaPath(), this->Serialize(SerializationFormat::Toml))) {
-				DebugLog(LOG_ERROR, "Failed to write meta file: " << this->GetMetaPath(), true);
-				if (boxer::Selection::Yes == boxer::show("Retry writing meta file, retry ?", "Retry ?", boxer::Style::Question, boxer::Buttons::YesNo)) {
-					this->~Asset();
-				}
-			}
+			this->SyncMeta();
 		}
 
+		void SyncMeta();
+
 		std::string GetMetaPath() { return this->GetFilePath() + ".meta"; }
 
 		bool HaveMeta() { return FileExist(this->GetMetaPath()); }
@@ -74,13 +91,41 @@ namespace PrettyEngine {
 	private:
 		std::string path;
 		Version version;
+		SerializationFormat metaFormat = SerializationFormat::Toml;
+	};
+
+	/// In-memory copy of the asset meta files, changes are written back in one batch by Flush.
+	class AssetMetaRegistry {
+	public:
+		/// Return the content of a meta file, read from the disk only the first time. Empty if there is no meta.
+		static std::string Get(const std::string& metaPath);
+		/// Mark the meta as dirty if the content changed.
+		static void Set(const std::string& metaPath, std::string content);
+		/// Write every dirty meta file, return the number of files written.
+		static size_t Flush();
+		static size_t GetDirtyCount();
 	};
 
+	/// Assets stored in assets.db, looked up by (path, name) through a unique index.
+	/// Safe to use from any thread, each thread read through its own connection.
 	class AssetDataBase {
 	public:
+		/// Shipped games never write their assets, must be called before the first use.
+		static void SetReadOnly(bool readOnly);
+
 		static std::vector<SQLBlobData> GetBinary(std::string directory, std::string assetName);
 		static std::vector<std::string> GetText(std::string directory, std::string assetName);
 		static void SetText(std::string directory, std::string assetName, std::string text);
+		static void SetBinary(std::string directory, std::string assetName, std::span<const unsigned char> data);
+
+		/// Size of a binary asset, -1 if there is none.
+		static int64_t GetBinarySize(const std::string& directory, const std::string& assetName);
+		/// Read a part of a binary asset without loading the rest, return false if out of range.
+		static bool ReadBinary(const std::string& directory, const std::string& assetName, size_t offset, std::span<unsigned char> out);
+
+		/// Group the writes until EndBatch in one transaction, batches can be nested.
+		static void BeginBatch();
+		static void EndBatch();
 	};
 }
 
@@ -0,0 +1,170 @@
+#ifndef HPP_ASSET_PREFETCHER
+#define HPP_ASSET_PREFETCHER
+
+#include <PrettyEngine/assetCache.hpp>
+#include <PrettyEngine/cooked.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/// Most threads a prefetcher use, loading is mostly waiting for the disk.
+#define ASSET_PREFETCH_MAX_WORKERS 4
+
+namespace PrettyEngine {
+	/// Load assets into an AssetCache in the background, before the objects using them ask for them.
+	/// The prefetched assets are referenced until released, so they can not be evicted before being used.
+	/// The loads are shared by a few worker threads, started on the first prefetch, whatever the number of assets.
+	class AssetPrefetcher {
+	public:
+		AssetPrefetcher() = default;
+
+		AssetPrefetcher(const AssetPrefetcher&) = delete;
+		AssetPrefetcher& operator=(const AssetPrefetcher&) = delete;
+
+		~AssetPrefetcher() {
+			this->Wait();
+
+			{
+				std::lock_guard lock(this->_mutex);
+				this->_stop = true;
+			}
+			this->_queued.notify_all();
+
+			for (auto & worker: this->_workers) {
+				worker.join();
+			}
+		}
+
+		void SetCache(AssetCache* newCache) { this->_cache = newCache; }
+
+		AssetCache* GetCache() const { return this->_cache; }
+
+		/// Queue public relative paths, the cooked version of an asset is the one loaded when there is one.
+		void Prefetch(const std::vector<std::string>& publicRelativePaths) {
+			if (this->_cache == nullptr) {
+				return;
+			}
+
+			std::vector<std::string> paths;
+			for (auto & publicRelativePath: publicRelativePaths) {
+				paths.push_back(FindCookedAsset(publicRelativePath, GetCookedExtension(publicRelativePath)));
+			}
+
+			size_t queuedCount = 0;
+			{
+				std::lock_guard lock(this->_mutex);
+				for (auto & path: paths) {
+					if (!this->_requested.insert(path).second) {
+						continue;
+					}
+
+					this->_queue.push_back(std::move(path));
+					this->_pending++;
+					queuedCount++;
+				}
+			}
+
+			if (queuedCount == 0) {
+				return;
+			}
+
+			this->StartWorkers();
+			this->_queued.notify_all();
+		}
+
+		size_t GetPendingCount() const {
+			std::lock_guard lock(this->_mutex);
+			return this->_pending;
+		}
+
+		/// Block until every queued load is done.
+		void Wait() {
+			std::unique_lock lock(this->_mutex);
+			this->_done.wait(lock, [this]{ return this->_pending == 0; });
+		}
+
+		/// Drop the references on the loaded assets, they stay in the cache until evicted. Pending loads are kept.
+		void Release() {
+			std::lock_guard lock(this->_mutex);
+			this->_handles.clear();
+			if (this->_pending == 0) {
+				this->_requested.clear();
+			}
+		}
+
+	private:
+		void StartWorkers() {
+			if (!this->_workers.empty()) {
+				return;
+			}
+
+			auto workerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, ASSET_PREFETCH_MAX_WORKERS);
+			for (size_t i = 0; i < workerCount; i++) {
+				this->_workers.emplace_back([this]{ this->RunWorker(); });
+			}
+		}
+
+		void RunWorker() {
+			std::unique_lock lock(this->_mutex);
+			while (true) {
+				this->_queued.wait(lock, [this]{ return this->_stop || !this->_queue.empty(); });
+				if (this->_queue.empty()) {
+					return;
+				}
+
+				auto path = std::move(this->_queue.front());
+				this->_queue.pop_front();
+				auto cache = this->_cache;
+
+				lock.unlock();
+				auto handle = cache->Acquire(path);
+				if (handle->Exist()) {
+					Touch(handle.GetData());
+				}
+				lock.lock();
+
+				this->_handles.push_back(std::move(handle));
+				this->_pending--;
+				if (this->_pending == 0) {
+					this->_done.notify_all();
+				}
+			}
+		}
+
+		/// Mapped files are only read from the disk when accessed, reading a byte per page bring the whole file in memory.
+		static void Touch(std::span<const unsigned char> data) {
+			constexpr size_t pageSize = 4096;
+
+			volatile unsigned char sum = 0;
+			for (size_t i = 0; i < data.size(); i += pageSize) {
+				sum = static_cast<unsigned char>(sum + data[i]);
+			}
+		}
+
+	private:
+		AssetCache* _cache = nullptr;
+
+		std::vector<std::thread> _workers;
+
+		mutable std::mutex _mutex;
+		std::condition_variable _queued;
+		std::condition_variable _done;
+		bool _stop = false;
+
+		/// Paths waiting for a worker.
+		std::deque<std::string> _queue;
+		/// Queued loads and loads in progress.
+		size_t _pending = 0;
+		std::vector<AssetHandle> _handles;
+		/// Paths already prefetched since the last release.
+		std::unordered_set<std::string> _requested;
+	};
+}
+
+#endif
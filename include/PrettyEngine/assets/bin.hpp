@@ -6,3 +6,5 @@
  * DO NOT MODIFY THIS FILE MANUALLY, AS IT WILL BE   *
  * REGENERATED AUTOMATICALLY UPON THE NEXT BUILD.    *
  ******************************************************/
+
+#include <PrettyEngine/builtinAssets.hpp>
@@ -0,0 +1,233 @@
+#ifndef H_BINARY
+#define H_BINARY
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace PrettyEngine {
+	/// Write little-endian values into a byte buffer.
+	class BinaryWriter {
+	public:
+		void WriteU8(uint8_t value) {
+			this->buffer.push_back(static_cast<char>(value));
+		}
+
+		void WriteU32(uint32_t value) {
+			for (int i = 0; i < 4; i++) {
+				this->WriteU8(static_cast<uint8_t>(value >> (i * 8)));
+			}
+		}
+
+		/// LEB128, small values like lengths and indices take a single byte.
+		void WriteVarU32(uint32_t value) {
+			while (value >= 0x80) {
+				this->WriteU8(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			this->WriteU8(static_cast<uint8_t>(value));
+		}
+
+		void WriteU64(uint64_t value) {
+			for (int i = 0; i < 8; i++) {
+				this->WriteU8(static_cast<uint8_t>(value >> (i * 8)));
+			}
+		}
+
+		void WriteF32(float value) {
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			this->WriteU32(bits);
+		}
+
+		void WriteBytes(std::string_view bytes) {
+			this->buffer.append(bytes.data(), bytes.size());
+		}
+
+		/// Length-prefixed string.
+		void WriteString(std::string_view value) {
+			this->WriteVarU32(static_cast<uint32_t>(value.size()));
+			this->WriteBytes(value);
+		}
+
+		size_t Size() const { return this->buffer.size(); }
+
+	public:
+		std::string buffer;
+	};
+
+	/// Read little-endian values from a byte buffer, any read past the end fail and set the reader as invalid.
+	class BinaryReader {
+	public:
+		BinaryReader(std::string_view newData) {
+			this->_data = newData;
+		}
+
+		bool ReadU8(uint8_t* out) {
+			if (!this->Require(1)) {
+				return false;
+			}
+			*out = static_cast<uint8_t>(this->_data[this->_position]);
+			this->_position++;
+			return true;
+		}
+
+		bool ReadU32(uint32_t* out) {
+			if (!this->Require(4)) {
+				return false;
+			}
+			*out = 0;
+			for (int i = 0; i < 4; i++) {
+				*out |= static_cast<uint32_t>(static_cast<uint8_t>(this->_data[this->_position + i])) << (i * 8);
+			}
+			this->_position += 4;
+			return true;
+		}
+
+		bool ReadVarU32(uint32_t* out) {
+			*out = 0;
+			for (int shift = 0; shift < 35; shift += 7) {
+				uint8_t byte;
+				if (!this->ReadU8(&byte)) {
+					return false;
+				}
+				*out |= static_cast<uint32_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) {
+					return true;
+				}
+			}
+			this->_valid = false;
+			return false;
+		}
+
+		bool ReadU64(uint64_t* out) {
+			if (!this->Require(8)) {
+				return false;
+			}
+			*out = 0;
+			for (int i = 0; i < 8; i++) {
+				*out |= static_cast<uint64_t>(static_cast<uint8_t>(this->_data[this->_position + i])) << (i * 8);
+			}
+			this->_position += 8;
+			return true;
+		}
+
+		bool ReadF32(float* out) {
+			uint32_t bits;
+			if (!this->ReadU32(&bits)) {
+				return false;
+			}
+			std::memcpy(out, &bits, sizeof(bits));
+			return true;
+		}
+
+		bool ReadBytes(size_t size, std::string_view* out) {
+			if (!this->Require(size)) {
+				return false;
+			}
+			*out = this->_data.substr(this->_position, size);
+			this->_position += size;
+			return true;
+		}
+
+		bool ReadString(std::string_view* out) {
+			uint32_t size;
+			return this->ReadVarU32(&size) && this->ReadBytes(size, out);
+		}
+
+		bool Skip(size_t size) {
+			std::string_view ignored;
+			return this->ReadBytes(size, &ignored);
+		}
+
+		bool Valid() const { return this->_valid; }
+
+		bool End() const { return this->_position >= this->_data.size(); }
+
+		size_t GetPosition() const { return this->_position; }
+
+	private:
+		bool Require(size_t size) {
+			if (!this->_valid || this->_data.size() - this->_position < size) {
+				this->_valid = false;
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		std::string_view _data;
+		size_t _position = 0;
+		bool _valid = true;
+	};
+
+	/// Hash accepting any string type, so the string table is searched without allocating a key.
+	struct BinaryStringHash {
+	public:
+		using is_transparent = void;
+
+		size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+	};
+
+	/// Deduplicate the strings of a binary document, each string is written once and referenced by index.
+	class BinaryStringTable {
+	public:
+		uint32_t Add(std::string_view value) {
+			auto found = this->_indices.find(value);
+			if (found != this->_indices.end()) {
+				return found->second;
+			}
+
+			auto index = static_cast<uint32_t>(this->strings.size());
+			this->strings.emplace_back(value);
+			this->_indices.emplace(this->strings.back(), index);
+			return index;
+		}
+
+		void Write(BinaryWriter* writer) const {
+			writer->WriteVarU32(static_cast<uint32_t>(this->strings.size()));
+			for (auto & string: this->strings) {
+				writer->WriteString(string);
+			}
+		}
+
+		bool Read(BinaryReader* reader) {
+			this->strings.clear();
+			this->_indices.clear();
+
+			uint32_t count;
+			if (!reader->ReadVarU32(&count)) {
+				return false;
+			}
+
+			for (uint32_t i = 0; i < count; i++) {
+				std::string_view string;
+				if (!reader->ReadString(&string)) {
+					return false;
+				}
+				this->strings.emplace_back(string);
+			}
+			return true;
+		}
+
+		/// Return nullptr if the index is out of the table.
+		const std::string* Get(uint32_t index) const {
+			if (index < this->strings.size()) {
+				return &this->strings[index];
+			}
+			return nullptr;
+		}
+
+	public:
+		std::vector<std::string> strings;
+
+	private:
+		std::unordered_map<std::string, uint32_t, BinaryStringHash, std::equal_to<>> _indices;
+	};
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef H_BUILTIN_ASSETS
+#define H_BUILTIN_ASSETS
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+/// Compression of a builtin asset in the index, gzip is only kept when it is smaller.
+#define BUILTIN_ASSET_STORED 0
+#define BUILTIN_ASSET_GZIP 1
+
+namespace PrettyEngine {
+	/// Entry of the index generated by assets.cmake.
+	struct BuiltinAssetEntry {
+	public:
+		/// Relative to ENGINE_BUILTIN, or "compiled/" then relative to ENGINE_COMPILED.
+		const char* path;
+		const unsigned char* data;
+		size_t dataSize;
+		size_t size;
+		int compression;
+	};
+
+	/// Every embedded asset, sorted by path. Defined in the generated builtinAssets.cpp.
+	std::span<const BuiltinAssetEntry> GetBuiltinAssetIndex();
+
+	bool BuiltinAssetExists(std::string_view path);
+
+	/// Content of a builtin asset, decompressed on first access then kept until the program exit. Empty if missing.
+	std::span<const unsigned char> GetBuiltinAssetData(std::string_view path);
+
+	/// Same as GetBuiltinAssetData, null-terminated for the ASSET_BUILTIN_ macros. "" if missing.
+	const char* GetBuiltinAsset(std::string_view path);
+
+	/// Number of builtin assets decompressed so far.
+	size_t GetBuiltinAssetLoadedCount();
+}
+
+#endif
@@ -218,7 +218,7 @@ namespace PrettyEngine {
 	public:
 		Mesh* mesh = nullptr;
 
-		std::string name = "DefaultColliderName";
+		InternedString name = "DefaultColliderName";
 
 		bool isRigidBody = false;
 
@@ -237,7 +237,7 @@ namespace PrettyEngine {
 		/// Collide only with objects that are fixed
 		bool fixedCollisionOnly = false;
 
-		std::string layer = "Default";
+		InternedString layer = "Default";
 
 		/// Reset the velocity each update
 		bool resetVelocity = true;
@@ -0,0 +1,102 @@
+#ifndef H_COOKED
+#define H_COOKED
+
+#include <PrettyEngine/utils.hpp>
+#include <PrettyEngine/vfs.hpp>
+
+#include <cctype>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Formats written by tools/cook, every value is little-endian and every data block aligned on COOKED_ALIGNMENT.
+/// - texture: magic, version, width, height, channels, mip count, then per level (offset u64, size u64, width, height), then the pixels.
+/// - mesh: magic, version, vertex count, index count, vertex offset (u64), index offset (u64), then the vertices (position, color, texture coord as floats) and the u32 indices.
+/// - localization: magic, version, line count, then per line a column count and the length-prefixed columns.
+#define COOKED_TEXTURE_MAGIC "PETX"
+#define COOKED_MESH_MAGIC "PEMS"
+#define COOKED_LOCALIZATION_MAGIC "PELC"
+#define COOKED_VERSION 1
+#define COOKED_ALIGNMENT 16
+/// Cooked files mirror the public directory under this one.
+#define COOKED_DIRECTORY "cooked/"
+
+namespace PrettyEngine {
+	class Mesh;
+
+	/// Return the cooked version of a public asset if tools/cook made one, the source asset otherwise.
+	static std::string FindCookedAsset(const std::string& publicRelativePath, std::string_view cookedExtension) {
+		auto cookedPath = GetEnginePublicPath(COOKED_DIRECTORY + publicRelativePath + std::string(cookedExtension), true);
+		if (VirtualFileSystem::Get()->Exists(cookedPath)) {
+			return cookedPath;
+		}
+		return GetEnginePublicPath(publicRelativePath, true);
+	}
+
+	/// Extension tools/cook give to the cooked version of an asset, empty if it is never cooked.
+	static std::string_view GetCookedExtension(std::string_view path) {
+		auto dot = path.find_last_of('.');
+		if (dot == std::string_view::npos) {
+			return "";
+		}
+
+		std::string extension(path.substr(dot));
+		for (auto & c: extension) {
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+
+		if (extension == ".png" || extension == ".jpg" || extension == ".jpeg") {
+			return ".ptex";
+		}
+		if (extension == ".obj") {
+			return ".pmesh";
+		}
+		// Only the localizations are cooked, the other csv have no cooked version to find.
+		if (extension == ".csv") {
+			return ".ploc";
+		}
+		return "";
+	}
+
+	static bool IsCooked(std::span<const unsigned char> data, const char* magic) {
+		return data.size() >= 4 && std::string_view(reinterpret_cast<const char*>(data.data()), 4) == magic;
+	}
+
+	struct CookedTextureLevel {
+	public:
+		int width = 0;
+		int height = 0;
+		std::span<const unsigned char> pixels;
+	};
+
+	/// View on a cooked texture, the pixels point into the given data and are ready for glTexImage2D.
+	/// tools/cook always writes RGBA pixels, the other channel counts are rejected.
+	class CookedTexture {
+	public:
+		bool Load(std::span<const unsigned char> data);
+
+		int GetWidth() const { return this->levels.empty() ? 0 : this->levels.front().width; }
+		int GetHeight() const { return this->levels.empty() ? 0 : this->levels.front().height; }
+		int GetChannels() const { return this->channels; }
+
+	public:
+		/// Mip levels, the full size first.
+		std::vector<CookedTextureLevel> levels;
+
+	private:
+		int channels = 0;
+	};
+
+	/// Fill the vertices and indices of a mesh from a cooked mesh, return false if the data are invalid.
+	bool LoadCookedMesh(std::span<const unsigned char> data, Mesh* out);
+
+	/// Load the cooked version of a public mesh asset, return false if tools/cook did not cook it. There is no runtime obj parser.
+	bool LoadCookedMeshAsset(const std::string& publicRelativePath, Mesh* out);
+
+	/// Lines of a cooked localization, in the layout of Localization::GetRawContent.
+	bool LoadCookedLocalization(std::span<const unsigned char> data, std::vector<std::vector<std::string>>* out);
+}
+
+#endif
@@ -7,9 +7,20 @@
 #include <cstring>
 #include <sqlite3/sqlite3.h>
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <thread>
 
 namespace PrettyEngine {
 	static int SQLite3Callback(void* notUsed, int argc, char** argv, char** colName) {
@@ -27,15 +38,138 @@ namespace PrettyEngine {
 		int bytes;
 	};
 
+	/// Prepared statement owned by the caller, reset it to run it again with other parameters.
+	class SQLStatement {
+	public:
+		SQLStatement() = default;
+
+		/// persistent tells SQLite the statement will be reused many times, only for the fixed statements kept in a cache.
+		SQLStatement(sqlite3* newDb, const std::string& sqlCommand, bool persistent = false) {
+			this->db = newDb;
+			if (sqlite3_prepare_v3(this->db, sqlCommand.c_str(), -1, persistent ? SQLITE_PREPARE_PERSISTENT : 0, &this->stmt, NULL) != SQLITE_OK) {
+				DebugLog(LOG_ERROR, "SQL prepare failed: " << sqlCommand, true);
+				DebugLog(LOG_ERROR, "SQL Error: " << sqlite3_errmsg(this->db), true);
+				this->stmt = nullptr;
+			}
+		}
+
+		~SQLStatement() {
+			sqlite3_finalize(this->stmt);
+		}
+
+		SQLStatement(const SQLStatement&) = delete;
+		SQLStatement& operator=(const SQLStatement&) = delete;
+
+		SQLStatement(SQLStatement&& other) noexcept {
+			this->db = other.db;
+			this->stmt = other.stmt;
+			other.stmt = nullptr;
+		}
+
+		SQLStatement& operator=(SQLStatement&& other) noexcept {
+			if (this != &other) {
+				sqlite3_finalize(this->stmt);
+				this->db = other.db;
+				this->stmt = other.stmt;
+				other.stmt = nullptr;
+			}
+			return *this;
+		}
+
+		bool Valid() const { return this->stmt != nullptr; }
+
+		/// Parameters start at 1, like in SQLite.
+		SQLStatement& Bind(int index, std::string_view text) {
+			sqlite3_bind_text(this->stmt, index, text.data(), static_cast<int>(text.size()), SQLITE_TRANSIENT);
+			return *this;
+		}
+
+		SQLStatement& Bind(int index, int64_t value) {
+			sqlite3_bind_int64(this->stmt, index, value);
+			return *this;
+		}
+
+		SQLStatement& BindBlob(int index, const void* data, size_t bytes) {
+			sqlite3_bind_blob64(this->stmt, index, data, bytes, SQLITE_TRANSIENT);
+			return *this;
+		}
+
+		/// Return true while there is a row to read.
+		bool Step() {
+			if (this->stmt == nullptr) {
+				return false;
+			}
+
+			auto rc = sqlite3_step(this->stmt);
+			if (rc == SQLITE_ROW) {
+				return true;
+			}
+			if (rc != SQLITE_DONE) {
+				DebugLog(LOG_ERROR, "SQL error during stepping: " << sqlite3_errmsg(this->db), true);
+			}
+			return false;
+		}
+
+		/// Clear the bindings and rewind the statement, to call before reusing it.
+		void Reset() {
+			sqlite3_reset(this->stmt);
+			sqlite3_clear_bindings(this->stmt);
+		}
+
+		int ColumnCount() { return sqlite3_column_count(this->stmt); }
+
+		int ColumnType(int column) { return sqlite3_column_type(this->stmt, column); }
+
+		int64_t ColumnInt(int column) { return sqlite3_column_int64(this->stmt, column); }
+
+		double ColumnDouble(int column) { return sqlite3_column_double(this->stmt, column); }
+
+		std::string_view ColumnText(int column) {
+			auto text = reinterpret_cast<const char*>(sqlite3_column_text(this->stmt, column));
+			return std::string_view(text != nullptr ? text : "", sqlite3_column_bytes(this->stmt, column));
+		}
+
+		std::span<const unsigned char> ColumnBlob(int column) {
+			auto data = static_cast<const unsigned char*>(sqlite3_column_blob(this->stmt, column));
+			return std::span<const unsigned char>(data, sqlite3_column_bytes(this->stmt, column));
+		}
+
+	private:
+		sqlite3* db = nullptr;
+		sqlite3_stmt* stmt = nullptr;
+	};
+
+	enum class JournalMode {
+		Delete,
+		Truncate,
+		Persist,
+		Memory,
+		WAL,
+		Off,
+	};
+
+	enum class SynchronousLevel {
+		Off,
+		Normal,
+		Full,
+		Extra,
+	};
+
 	class DataBase {
 	public:
-		DataBase(std::string fileName) {
-			if (sqlite3_open(fileName.c_str(), &this->db) != 0) {
+		/// Each connection must be used by one thread at a time, use a DataBasePool to share a database between threads.
+		DataBase(std::string fileName, bool readOnly = false) {
+			const int flags = (readOnly ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE) | SQLITE_OPEN_NOMUTEX;
+			if (sqlite3_open_v2(fileName.c_str(), &this->db, flags, NULL) != 0) {
 				DebugLog(LOG_ERROR, "Failed to open database file: " << fileName, true);
 			}
+			// Wait for the other connections instead of failing at once.
+			sqlite3_busy_timeout(this->db, 5000);
 		}
 
 		~DataBase() {
+			// Statements must be finalized before the connection can close.
+			this->ClearStatementCache();
 			while(SQLITE_BUSY == sqlite3_close(this->db)) {};
 		}
 
@@ -52,54 +186,129 @@ namespace PrettyEngine {
 			sqlite3_free(errMsg);
 		}
 
-		std::vector<int> QuerySQLInt(std::string sqlCommand) {
-			std::vector<int> out;
+		void SetJournalMode(JournalMode mode) {
+			const char* names[] = { "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF" };
 
-			sqlite3_stmt *stmt;
-			
-			auto rc = sqlite3_prepare_v2(this->db, sqlCommand.c_str(), -1, &stmt, NULL);
+			// The pragma answer with the mode in use, which may differ (in-memory databases can not use WAL).
+			auto statement = this->Prepare(std::string("PRAGMA journal_mode = ") + names[static_cast<int>(mode)]);
+			if (statement.Step() && sqlite3_stricmp(statement.ColumnText(0).data(), names[static_cast<int>(mode)]) != 0) {
+				DebugLog(LOG_WARNING, "Journal mode " << names[static_cast<int>(mode)] << " not available, using: " << statement.ColumnText(0), false);
+			}
+		}
 
-			while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        		int numColumns = sqlite3_column_count(stmt);
-        		
-        		for(int column = 0; column < numColumns; column++) {
-    				if (sqlite3_column_type(stmt, column) == SQLITE_INTEGER) {
-    					out.push_back(sqlite3_column_int(stmt, column));
-    				}
-        		}
-        	}
+		void SetSynchronous(SynchronousLevel level) {
+			const char* names[] = { "OFF", "NORMAL", "FULL", "EXTRA" };
+			this->ExecuteSQL(std::string("PRAGMA synchronous = ") + names[static_cast<int>(level)]);
+		}
 
-        	if (rc != SQLITE_DONE) {
-    			DebugLog(LOG_ERROR, "SQL error during stepping: " << sqlite3_errmsg(this->db), true);
+		/// Transactions can be nested, only the outermost one is sent to SQLite.
+		void BeginTransaction() {
+			if (this->transactionDepth++ == 0) {
+				this->transactionFailed = false;
+				this->ExecuteSQL("BEGIN");
 			}
+		}
 
-			sqlite3_finalize(stmt);
+		/// Commit the outermost transaction, or roll it back if a nested one was rolled back.
+		void CommitTransaction() {
+			if (this->transactionDepth == 0) {
+				DebugLog(LOG_ERROR, "Commit without transaction", false);
+				return;
+			}
+			if (--this->transactionDepth == 0) {
+				this->ExecuteSQL(this->transactionFailed ? "ROLLBACK" : "COMMIT");
+			}
+		}
 
-			return out;
+		void RollbackTransaction() {
+			if (this->transactionDepth == 0) {
+				DebugLog(LOG_ERROR, "Rollback without transaction", false);
+				return;
+			}
+			this->transactionFailed = true;
+			if (--this->transactionDepth == 0) {
+				this->ExecuteSQL("ROLLBACK");
+			}
 		}
 
-		std::vector<double> QuerySQLDouble(std::string sqlCommand) {
-			std::vector<double> out;
+		bool InTransaction() const { return this->transactionDepth > 0; }
+
+		/// Prepared statement kept in a least recently used cache, ready to be bound.
+		/// The cache may drop it later but it stay valid as long as the returned pointer is kept.
+		/// Only for fixed SQL run again and again, with the values bound as parameters.
+		std::shared_ptr<SQLStatement> GetStatement(const std::string& sqlCommand) {
+			auto found = this->statementCache.find(sqlCommand);
+			if (found != this->statementCache.end()) {
+				this->statementOrder.splice(this->statementOrder.begin(), this->statementOrder, found->second.position);
+				found->second.statement->Reset();
+				return found->second.statement;
+			}
+
+			auto statement = std::make_shared<SQLStatement>(this->db, sqlCommand, true);
+			if (!statement->Valid()) {
+				return statement;
+			}
+
+			this->statementOrder.push_front(sqlCommand);
+			this->statementCache.insert({ sqlCommand, CachedStatement{ statement, this->statementOrder.begin() } });
+			this->TrimStatementCache();
+
+			return statement;
+		}
+
+		void SetStatementCacheSize(size_t size) {
+			this->statementCacheSize = size;
+			this->TrimStatementCache();
+		}
 
-			sqlite3_stmt *stmt;
-			
-			auto rc = sqlite3_prepare_v2(this->db, sqlCommand.c_str(), -1, &stmt, NULL);
+		size_t GetStatementCacheCount() const { return this->statementCache.size(); }
 
-			while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        		int numColumns = sqlite3_column_count(stmt);
-        		
-        		for(int column = 0; column < numColumns; column++) {
-    				if (sqlite3_column_type(stmt, column) == SQLITE_FLOAT) {
-    					out.push_back(sqlite3_column_double(stmt, column));
-    				}
-        		}
-        	}
+		void ClearStatementCache() {
+			this->statementCache.clear();
+			this->statementOrder.clear();
+		}
 
-        	if (rc != SQLITE_DONE) {
-    			DebugLog(LOG_ERROR, "SQL error during stepping: " << sqlite3_errmsg(this->db), true);
+		/// Call function with the statement positioned on each row, the columns are read in place.
+		/// Stop early if function return false.
+		/// The SQL is prepared for this call only, so ad-hoc queries do not fill the statement cache.
+		template<typename Function>
+		void ForEachRow(const std::string& sqlCommand, Function function) {
+			auto statement = this->Prepare(sqlCommand);
+			while (statement.Step()) {
+				if constexpr (std::is_same_v<std::invoke_result_t<Function, SQLStatement&>, bool>) {
+					if (!function(statement)) {
+						break;
+					}
+				} else {
+					function(statement);
+				}
 			}
+		}
 
-			sqlite3_finalize(stmt);
+		std::vector<int> QuerySQLInt(std::string sqlCommand) {
+			std::vector<int> out;
+
+			this->ForEachRow(sqlCommand, [&out](SQLStatement& row) {
+				for (int column = 0; column < row.ColumnCount(); column++) {
+					if (row.ColumnType(column) == SQLITE_INTEGER) {
+						out.push_back(static_cast<int>(row.ColumnInt(column)));
+					}
+				}
+			});
+
+			return out;
+		}
+
+		std::vector<double> QuerySQLDouble(std::string sqlCommand) {
+			std::vector<double> out;
+
+			this->ForEachRow(sqlCommand, [&out](SQLStatement& row) {
+				for (int column = 0; column < row.ColumnCount(); column++) {
+					if (row.ColumnType(column) == SQLITE_FLOAT) {
+						out.push_back(row.ColumnDouble(column));
+					}
+				}
+			});
 
 			return out;
 		}
@@ -107,71 +316,256 @@ namespace PrettyEngine {
 		std::vector<std::string> QuerySQLText(std::string sqlCommand) {
 			std::vector<std::string> out;
 
-			sqlite3_stmt *stmt;
-			
-			auto rc = sqlite3_prepare_v2(this->db, sqlCommand.c_str(), -1, &stmt, NULL);
+			this->ForEachRow(sqlCommand, [&out](SQLStatement& row) {
+				for (int column = 0; column < row.ColumnCount(); column++) {
+					if (row.ColumnType(column) == SQLITE_TEXT) {
+						out.push_back(std::string(row.ColumnText(column)));
+					}
+				}
+			});
+
+			return out;
+		}
+
+		std::vector<SQLBlobData> QuerySQLBlob(std::string sqlCommand) {
+			std::vector<SQLBlobData> out;
+
+			this->ForEachRow(sqlCommand, [&out](SQLStatement& row) {
+				for (int column = 0; column < row.ColumnCount(); column++) {
+					if (row.ColumnType(column) == SQLITE_BLOB) {
+						auto blob = row.ColumnBlob(column);
+
+						SQLBlobData data;
+						data.data.assign(blob.begin(), blob.end());
+						data.bytes = static_cast<int>(blob.size());
+						out.push_back(std::move(data));
+					}
+				}
+			});
+
+			return out;
+		}
 
-			while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        		int numColumns = sqlite3_column_count(stmt);
-        		
-        		for(int column = 0; column < numColumns; column++) {
-    				if (sqlite3_column_type(stmt, column) == SQLITE_TEXT) {
-    					std::stringstream ss;
-    					ss << sqlite3_column_text(stmt, column);
+		SQLStatement Prepare(const std::string& sqlCommand) {
+			return SQLStatement(this->db, sqlCommand);
+		}
 
-    					out.push_back(ss.str());
-    				}
-        		}
-        	}
+		sqlite3* GetHandle() { return this->db; }
 
-        	if (rc != SQLITE_DONE) {
-    			DebugLog(LOG_ERROR, "SQL error during stepping: " << sqlite3_errmsg(this->db), true);
+	private:
+		void TrimStatementCache() {
+			while (this->statementCache.size() > this->statementCacheSize) {
+				this->statementCache.erase(this->statementOrder.back());
+				this->statementOrder.pop_back();
 			}
+		}
 
-			sqlite3_finalize(stmt);
+	private:
+		struct CachedStatement {
+			std::shared_ptr<SQLStatement> statement;
+			std::list<std::string>::iterator position;
+		};
 
-			return out;
+		sqlite3* db;
+
+		int transactionDepth = 0;
+		bool transactionFailed = false;
+
+		size_t statementCacheSize = 64;
+		/// Most recently used first.
+		std::list<std::string> statementOrder;
+		std::unordered_map<std::string, CachedStatement> statementCache;
+	};
+
+	/// Roll back the transaction when destroyed unless it was committed.
+	class SQLTransaction {
+	public:
+		SQLTransaction(DataBase* newDataBase) {
+			this->dataBase = newDataBase;
+			this->dataBase->BeginTransaction();
 		}
 
-		std::vector<SQLBlobData> QuerySQLBlob(std::string sqlCommand) {
-			std::vector<SQLBlobData> out;
+		~SQLTransaction() {
+			if (!this->done) {
+				this->dataBase->RollbackTransaction();
+			}
+		}
 
-			sqlite3_stmt *stmt;
-			
-			auto rc = sqlite3_prepare_v2(this->db, sqlCommand.c_str(), -1, &stmt, NULL);
+		SQLTransaction(const SQLTransaction&) = delete;
+		SQLTransaction& operator=(const SQLTransaction&) = delete;
 
-			while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        		int numColumns = sqlite3_column_count(stmt);
-        		
-        		for(int column = 0; column < numColumns; column++) {
-        			if (sqlite3_column_type(stmt, column) == SQLITE_BLOB) {
-	    				const unsigned char* blobData = static_cast<const unsigned char*>(sqlite3_column_blob(stmt, column));
-						int blobSize = sqlite3_column_bytes(stmt, column);
+		void Commit() {
+			if (!this->done) {
+				this->done = true;
+				this->dataBase->CommitTransaction();
+			}
+		}
 
-						std::vector<unsigned char> dataVector(blobData, blobData + blobSize);
-				        for (int i = 0; i < blobSize; ++i) {
-				            dataVector[i] = blobData[i];
-				        }
+	private:
+		DataBase* dataBase;
+		bool done = false;
+	};
 
-				        SQLBlobData data;
-				        data.data = dataVector;
-				        data.bytes = blobSize; 
-				        out.push_back(data);
-			        }
-        		}
-        	}
+	/// Share a database file between threads: each thread read through its own connection, and the writes go through a single connection, one thread at a time.
+	/// Nothing is opened before the first use.
+	/// Read connections of a DataBasePool, one per thread.
+	struct DataBaseReaders {
+	public:
+		std::mutex mutex;
+		std::unordered_map<std::thread::id, std::unique_ptr<DataBase>> connections;
+	};
 
-        	if (rc != SQLITE_DONE) {
-    			DebugLog(LOG_ERROR, "SQL error during stepping: " << sqlite3_errmsg(this->db), true);
+	/// Close the read connections a thread opened when it ends, so a later thread given the same id does not inherit them.
+	class DataBaseReadersRelease {
+	public:
+		~DataBaseReadersRelease() {
+			for (auto & weakReaders: this->_readers) {
+				// The pool may be gone before the thread.
+				if (auto readers = weakReaders.lock()) {
+					std::lock_guard lock(readers->mutex);
+					readers->connections.erase(std::this_thread::get_id());
+				}
 			}
+		}
 
-			sqlite3_finalize(stmt);
+		/// Release of the calling thread.
+		static DataBaseReadersRelease* Get() {
+			thread_local DataBaseReadersRelease release;
+			return &release;
+		}
 
-			return out;
+		void Add(std::weak_ptr<DataBaseReaders> readers) {
+			this->_readers.push_back(std::move(readers));
 		}
 
 	private:
-		sqlite3* db;
+		std::vector<std::weak_ptr<DataBaseReaders>> _readers;
+	};
+
+	class DataBasePool {
+	public:
+		DataBasePool(std::string newFileName, std::function<void(DataBase*)> newSetup = nullptr) {
+			this->fileName = newFileName;
+			this->setup = newSetup;
+		}
+
+		/// Must be called before the first use.
+		void SetReadOnly(bool newReadOnly) { this->readOnly = newReadOnly; }
+
+		bool IsReadOnly() const { return this->readOnly; }
+
+		/// Connection of the calling thread, in a transaction started by this thread it is the writer so the pending writes are visible.
+		/// The connection is closed when the thread ends.
+		DataBase* GetReader() {
+			this->EnsureSetup();
+
+			if (this->transactionOwner == std::this_thread::get_id()) {
+				return this->writer.get();
+			}
+
+			std::lock_guard lock(this->readers->mutex);
+			auto & reader = this->readers->connections[std::this_thread::get_id()];
+			if (reader == nullptr) {
+				reader = std::make_unique<DataBase>(this->fileName, true);
+				DataBaseReadersRelease::Get()->Add(this->readers);
+			}
+			return reader.get();
+		}
+
+		/// Close the connection of the calling thread before it ends.
+		void ReleaseReader() {
+			std::lock_guard lock(this->readers->mutex);
+			this->readers->connections.erase(std::this_thread::get_id());
+		}
+
+		size_t GetReaderCount() {
+			std::lock_guard lock(this->readers->mutex);
+			return this->readers->connections.size();
+		}
+
+		/// Run function with the writer, other threads wait until it return. Return false in read-only mode.
+		template<typename Function>
+		bool Write(Function function) {
+			if (!this->CheckWritable()) {
+				return false;
+			}
+
+			std::lock_guard lock(this->writerMutex);
+			function(this->OpenWriter());
+			return true;
+		}
+
+		/// Keep the writer for the calling thread until CommitTransaction, the writes in between are grouped.
+		/// The writer stay locked between the two calls, Write from the same thread is allowed.
+		bool BeginTransaction() {
+			if (!this->CheckWritable()) {
+				return false;
+			}
+
+			this->writerMutex.lock();
+			this->OpenWriter()->BeginTransaction();
+			this->transactionOwner = std::this_thread::get_id();
+			this->transactionDepth++;
+			return true;
+		}
+
+		void CommitTransaction() {
+			if (this->transactionOwner != std::this_thread::get_id()) {
+				DebugLog(LOG_ERROR, "Commit from a thread without transaction", false);
+				return;
+			}
+
+			// Adopt the lock taken by BeginTransaction
+			std::lock_guard lock(this->writerMutex, std::adopt_lock);
+			this->writer->CommitTransaction();
+			if (--this->transactionDepth == 0) {
+				this->transactionOwner = std::thread::id();
+			}
+		}
+
+	private:
+		void EnsureSetup() {
+			if (!this->ready && !this->readOnly) {
+				std::lock_guard lock(this->writerMutex);
+				this->OpenWriter();
+			}
+		}
+
+		bool CheckWritable() {
+			if (this->readOnly) {
+				DebugLog(LOG_ERROR, "Write to read-only database: " << this->fileName, false);
+				return false;
+			}
+			return true;
+		}
+
+		/// Open the writer on first use, writerMutex must be held.
+		DataBase* OpenWriter() {
+			if (this->writer == nullptr) {
+				this->writer = std::make_unique<DataBase>(this->fileName);
+				if (this->setup) {
+					this->setup(this->writer.get());
+				}
+				this->ready = true;
+			}
+			return this->writer.get();
+		}
+
+	private:
+		std::string fileName;
+		bool readOnly = false;
+		/// Called once on the writer when it is opened, before any reader. Skipped in read-only mode.
+		std::function<void(DataBase*)> setup;
+		/// True once the setup ran, the readers wait for it.
+		std::atomic<bool> ready = false;
+
+		std::recursive_mutex writerMutex;
+		std::unique_ptr<DataBase> writer;
+		std::atomic<std::thread::id> transactionOwner;
+		int transactionDepth = 0;
+
+		/// Shared with the threads that opened a reader, to close it when they end.
+		std::shared_ptr<DataBaseReaders> readers = std::make_shared<DataBaseReaders>();
 	};
 }
 
@@ -10,6 +10,7 @@
 #include <Guid.hpp>
 
 #include <string>
+#include <vector>
 #include <functional>
 
 namespace PrettyEngine {
@@ -40,19 +41,24 @@ namespace PrettyEngine {
 
 			this->_container.HaveValue([this](SerialObject* value) {
 				value->AddSerializedField(typeid(T).name(), this->_name, (this->_serializeFunction)(this->_value));
+				this->_slot = value->GetSerializedFieldSlot(this->_name);
 			});
 			this->UpdateValue();
 		}
 
 		void UpdateValue() {
 			this->_container.HaveValue([this](SerialObject* value) {
-				this->_value = this->_deserializeFunction(value->GetSerializedFieldValue(this->_name));
+				if (auto field = value->ResolveSerializedField(&this->_slot, this->_name)) {
+					this->_value = this->_deserializeFunction(field->value);
+				}
 			});
 		}
 
 		void Save() {
 			this->_container.HaveValue([this](SerialObject* value) {
-				value->GetSerializedField(this->_name)->value = (this->_serializeFunction)(this->_value);
+				if (auto field = value->ResolveSerializedField(&this->_slot, this->_name)) {
+					field->value = (this->_serializeFunction)(this->_value);
+				}
 			});
 		}
 
@@ -66,7 +72,8 @@ namespace PrettyEngine {
 
 		Option<SerialObject*> _container = Option<SerialObject*>(nullptr);
 
-		std::string _name;
+		InternedString _name;
+		size_t _slot = SERIAL_FIELD_NO_SLOT;
 
 		T _value;
 	};
@@ -112,6 +119,8 @@ namespace PrettyEngine {
 		virtual void OnRender() {}
 		/// Called just before updating the physics.
 		virtual void OnPrePhysics() {}
+		/// Add the public relative paths of the assets used by the object, saved with its world to prefetch them when it is loaded.
+		virtual void CollectAssetDependencies(std::vector<std::string>* out) {}
 
 		/// Create a public var but do not override
 		void CreatePublicVar(std::string name, std::string defaultValue = "") {
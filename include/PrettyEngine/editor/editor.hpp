@@ -35,14 +35,18 @@ class Editor {
 		auto componentListFile = GetEnginePublicPath("../../components/list.csv", true);
 		if (FileExist(componentListFile)) {
 			auto fileContent = ReadFileToString(componentListFile);
-			this->existingComponents = ParseCSVLine(fileContent);
+			for (auto & componentName: ParseCSVLine(fileContent)) {
+				this->existingComponents.emplace_back(componentName);
+			}
 		}
 
 		// Load the list of all entities
 		auto entitiesListFile = GetEnginePublicPath("../../entities/list.csv", true);
 		if (FileExist(entitiesListFile)) {
 			auto fileContent = ReadFileToString(entitiesListFile);
-			this->existingEntities = ParseCSVLine(fileContent);
+			for (auto & entityName: ParseCSVLine(fileContent)) {
+				this->existingEntities.emplace_back(entityName);
+			}
 		}
 
 		this->_propertyEditorList = GeneratePropertyEditorList();
@@ -100,7 +104,7 @@ class Editor {
 	void ShowCreateNewEntity(std::shared_ptr<World> world) {
 		for (auto &entity : this->existingEntities) {
 			std::string buttonName = "Add Entity: ";
-			buttonName += entity;
+			buttonName += entity.str();
 			if (ImGui::Button(buttonName.c_str())) {	
 					world->RegisterEntity(CreateCustomEntity(entity));
     			int entitiesWithSameName = 0;
@@ -118,22 +122,32 @@ class Editor {
 		}
 	}
 
-	void ShowToolScripts() {
-		if (ImGui::Begin("Tool Scripts")) {
-			for (auto &entry : std::filesystem::recursive_directory_iterator(GetEnginePublicPath("../../tools", true))) {
+	/// The list of scripts is only made again when the tools directory change.
+	void ShowToolScripts(FileWatcher* fileWatcher) {
+		const auto toolsDirectory = GetEnginePublicPath("../../tools", true);
+		if (!this->toolScriptsListed || fileWatcher->ChangedIn(toolsDirectory)) {
+			this->toolScripts.clear();
+			for (auto &entry : std::filesystem::recursive_directory_iterator(toolsDirectory)) {
 				if (!entry.is_directory() && entry.path().extension() == ".go") {
-					std::string buttonName = "Run: ";
-					buttonName += entry.path().filename().string();
-					if (ImGui::Button(buttonName.c_str())) {
-						std::string command;
-						command += "go run ";
-						command += '\"' + entry.path().string() + '\"';
-						DebugLog(LOG_INFO, "Execute script: " << entry.path().parent_path(), true);
-						if (system(command.c_str())) {
-							DebugLog(LOG_ERROR, "Script failed", true);
-						} else {
-							DebugLog(LOG_INFO, "Script succeed", true);
-						}
+					this->toolScripts.push_back(entry.path());
+				}
+			}
+			this->toolScriptsListed = true;
+		}
+
+		if (ImGui::Begin("Tool Scripts")) {
+			for (auto &script : this->toolScripts) {
+				std::string buttonName = "Run: ";
+				buttonName += script.filename().string();
+				if (ImGui::Button(buttonName.c_str())) {
+					std::string command;
+					command += "go run ";
+					command += '\"' + script.string() + '\"';
+					DebugLog(LOG_INFO, "Execute script: " << script.parent_path(), true);
+					if (system(command.c_str())) {
+						DebugLog(LOG_ERROR, "Script failed", true);
+					} else {
+						DebugLog(LOG_INFO, "Script succeed", true);
 					}
 				}
 			}
@@ -291,7 +305,7 @@ class Editor {
 							std::string newComponentName = componentName;
 
 							for (auto &component : selectedEntity->components) {
-								if (!component->serialObjectUnique.empty() && component->serialObjectUnique.starts_with(componentName)) {
+								if (!component->serialObjectUnique.empty() && component->serialObjectUnique.starts_with(componentName.view())) {
 									componentNameCount++;
 								}
 							}
@@ -473,7 +487,7 @@ class Editor {
 			this->ShowWorldEditor(worldManager);
 			this->ShowSelectedEntities();
 			this->ShowRenderDebugger(&engineContent->renderer);
-			this->ShowToolScripts();
+			this->ShowToolScripts(&engineContent->fileWatcher);
 			this->ShowCollisionDebugger(engineContent);
 		} else {
 			DebugLog(LOG_ERROR, "Nullptr of WorldManager", true);
@@ -491,11 +505,15 @@ class Editor {
 
 	std::vector<Entity*> selectedEntities;
 
-	std::vector<std::string> existingComponents;
-	std::vector<std::string> existingEntities;
+	/// Names of the custom objects, interned once as every object created from them use them as serialObjectName.
+	std::vector<InternedString> existingComponents;
+	std::vector<InternedString> existingEntities;
 
 	std::vector<std::shared_ptr<PropertyEditor>> _propertyEditorList;
 
+	std::vector<std::filesystem::path> toolScripts;
+	bool toolScriptsListed = false;
+
 	bool createComponent = false;
 };
 } // namespace PrettyEngine
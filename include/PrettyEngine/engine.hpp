@@ -14,6 +14,7 @@
 #include <PrettyEngine/render/render.hpp>
 #include <PrettyEngine/render/texture.hpp>
 #include <PrettyEngine/utils.hpp>
+#include <PrettyEngine/vfs.hpp>
 #include <PrettyEngine/worldLoad.hpp>
 
 #include <implot.h>
@@ -31,8 +32,18 @@ class Engine final: public EventListener {
 
 		#if ENGINE_EDITOR
 		this->editor = new Editor();
+
+		this->engineContent.fileWatcher.Watch(GetEnginePublicPath("", true));
+		this->engineContent.fileWatcher.Watch(GetEnginePublicPath("../../tools", true));
+		#else
+		AssetDataBase::SetReadOnly(true);
 		#endif
 
+		this->_worldManager.SetAssetCache(&this->engineContent.assetCache);
+
+		// Loose files stay first, the pack is only used for what is missing from the public directory.
+		VirtualFileSystem::Get()->MountPublic(GetEnginePublicPath("", true), "./public.pak");
+
 		auto customConfig = toml::parse(config);
 
 		const int antiAliasing = customConfig["engine"]["render"]["antiAliasing"].value_or(8);
@@ -88,6 +99,12 @@ class Engine final: public EventListener {
 		this->_worldManager.ClearWorldInstances();
 		this->_worldManager.Clear();
 
+		// The prefetched assets are in the cache of the engine content, destroyed before the world manager.
+		this->_worldManager.GetPrefetcher()->Wait();
+		this->_worldManager.GetPrefetcher()->Release();
+
+		AssetMetaRegistry::Flush();
+
 		#if ENGINE_EDITOR
 		delete this->editor;
 		#endif
@@ -144,6 +161,10 @@ class Engine final: public EventListener {
 			}
 		}
 #endif
+#if ENGINE_EDITOR
+		this->HotReload();
+#endif
+
 		auto worlds = this->_worldManager.GetWorlds();
 		this->engineContent.input.Update();
 
@@ -198,6 +219,13 @@ class Engine final: public EventListener {
 			}
 		}
 
+		// The worlds started during this frame, their objects hold the assets they use now.
+		this->_worldManager.ReleasePrefetchedAssets();
+
+		if (!this->isEditor && this->_worldManager.RollbackEnabled()) {
+			this->_worldManager.CaptureSnapshot(&this->engineContent.physicalSpace);
+		}
+
 		auto requests = this->GetWorldManager()->GetAllDynamicObjectsRequests();
 		for (auto &request : requests) {
 			if (request == Request::SAVE) {
@@ -215,6 +243,43 @@ class Engine final: public EventListener {
 #endif
 	}
 
+	/// Apply the changes made to the files since the last frame: textures are uploaded again in place,
+	/// worlds are loaded again while editing, and a "file_changed" event is sent for every file.
+	void HotReload() {
+		auto fileWatcher = &this->engineContent.fileWatcher;
+		fileWatcher->Update();
+
+		if (fileWatcher->GetChanges().empty()) {
+			return;
+		}
+
+		// New or deleted loose files change which layer hold a path.
+		VirtualFileSystem::Get()->InvalidateResolution();
+
+		// The texture names are the paths they were loaded from, but maybe not in the normalized form of the changes.
+		std::vector<std::string> changedTextures;
+		for (auto & texture: this->engineContent.renderer.glTextures) {
+			if (fileWatcher->Changed(texture.first)) {
+				changedTextures.push_back(texture.first);
+			}
+		}
+		for (auto & name: changedTextures) {
+			this->engineContent.renderer.ReloadTexture(name, &this->engineContent.assetCache);
+		}
+
+		for (auto & path: fileWatcher->GetChanges()) {
+			Event event;
+			event.name = path;
+			event.content = nullptr;
+			event.AddTag("file_changed");
+			this->engineContent.eventManager.SendEvent(&event);
+		}
+
+		if (this->isEditor && this->_worldManager.ReloadChangedWorlds(fileWatcher)) {
+			this->SetupWorlds();
+		}
+	}
+
 	void OnEvent(Event *event) override { 
 		if (event->HaveTag("save")) {
 			this->GetWorldManager()->SaveWorlds();
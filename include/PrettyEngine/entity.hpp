@@ -53,7 +53,7 @@ namespace PrettyEngine {
   		/// True if start was never called.
 		bool worldFirst = true;
 
-		std::string entityName = DEFAULT_ENTITY_NAME;
+		InternedString entityName = DEFAULT_ENTITY_NAME;
 
 		template<typename T>
 		T* AddComponent(std::string name) {
@@ -0,0 +1,69 @@
+#ifndef HPP_FILE_WATCHER
+#define HPP_FILE_WATCHER
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace PrettyEngine {
+	/// Report the files changed in watched directories, using inotify on Linux and polling elsewhere.
+	/// Several events on the same file are coalesced until it stay unchanged for coalesceDelay.
+	class FileWatcher {
+	public:
+		FileWatcher() = default;
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		/// Watch a directory and its sub-directories.
+		bool Watch(const std::string& directory);
+
+		/// Collect the events, to call once per frame. The changes stay available until the next call.
+		void Update();
+
+		const std::vector<std::string>& GetChanges() const { return this->_changes; }
+
+		bool Changed(std::string_view path) const { return this->_changedSet.contains(Normalize(path)); }
+
+		/// True if a file of the directory, or of its sub-directories, changed.
+		bool ChangedIn(std::string_view directory) const;
+
+		bool UseNotify() const { return this->_notify >= 0; }
+
+		/// Same form as the reported changes.
+		static std::string Normalize(std::string_view path);
+
+	public:
+		std::chrono::milliseconds coalesceDelay = std::chrono::milliseconds(100);
+		/// Only used without inotify.
+		std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000);
+
+	private:
+		void AddWatch(const std::string& directory);
+		void ReadNotify();
+		void Poll();
+		void Touch(const std::string& path);
+
+	private:
+		int _notify = -1;
+		std::unordered_map<int, std::string> _watchDescriptors;
+
+		std::vector<std::string> _directories;
+		/// Last write time of each file, for polling.
+		std::unordered_map<std::string, std::filesystem::file_time_type> _snapshot;
+		std::chrono::steady_clock::time_point _lastPoll;
+
+		/// Files with recent events, reported once they stay quiet.
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> _pending;
+
+		std::vector<std::string> _changes;
+		std::unordered_set<std::string> _changedSet;
+	};
+}
+
+#endif
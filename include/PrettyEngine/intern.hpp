@@ -0,0 +1,66 @@
+#ifndef H_INTERN
+#define H_INTERN
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace PrettyEngine {
+	/// Identifier-like string stored once in an engine-wide pool, copies share the same storage and compare by address.
+	class InternedString {
+	public:
+		InternedString() { this->_value = Empty(); }
+		InternedString(std::string_view value) { this->_value = Intern(value); }
+		InternedString(const std::string& value) { this->_value = Intern(value); }
+		InternedString(const char* value) { this->_value = Intern(value); }
+
+		/// Look for a string in the pool without adding it, return false if it was never interned.
+		static bool Find(std::string_view value, InternedString* out);
+
+		/// Number of unique strings in the pool.
+		static size_t GetPoolSize();
+
+		const std::string& str() const { return *this->_value; }
+		const char* c_str() const { return this->_value->c_str(); }
+		std::string_view view() const { return *this->_value; }
+
+		bool empty() const { return this->_value->empty(); }
+		size_t size() const { return this->_value->size(); }
+
+		operator const std::string&() const { return *this->_value; }
+		operator std::string_view() const { return *this->_value; }
+
+		bool operator==(const InternedString& other) const { return this->_value == other._value; }
+		bool operator==(const std::string& other) const { return *this->_value == other; }
+		bool operator==(std::string_view other) const { return *this->_value == other; }
+		bool operator==(const char* other) const { return *this->_value == other; }
+
+		friend std::string operator+(const InternedString& a, const std::string& b) { return *a._value + b; }
+		friend std::string operator+(const std::string& a, const InternedString& b) { return a + *b._value; }
+		friend std::string operator+(const InternedString& a, const char* b) { return *a._value + b; }
+		friend std::string operator+(const char* a, const InternedString& b) { return a + *b._value; }
+
+		friend std::ostream& operator<<(std::ostream& out, const InternedString& value) { return out << *value._value; }
+
+		/// Address of the pooled string, the same for every equal string.
+		const void* GetID() const { return this->_value; }
+
+	private:
+		static const std::string* Intern(std::string_view value);
+		static const std::string* Empty();
+
+	private:
+		const std::string* _value;
+	};
+}
+
+/// Hash the content and not the pooled address, so the iteration order of hashed containers is the same from one run to the next.
+template<>
+struct std::hash<PrettyEngine::InternedString> {
+	size_t operator()(const PrettyEngine::InternedString& value) const {
+		return std::hash<std::string_view>{}(value.view());
+	}
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <PrettyEngine/debug/debug.hpp>
 #include <PrettyEngine/utils.hpp>
+#include <PrettyEngine/cooked.hpp>
 
 #include <cstddef>
 #include <fstream>
@@ -41,12 +42,31 @@ namespace PrettyEngine {
 
 	class Localization {
 	public:
+		/// Load a csv file or a localization cooked by tools/cook.
 		void LoadFile(std::string path) {
 			this->filePath = path;
-			auto fileContent = ReadFileToString(path);
+			auto fileContent = VirtualFileSystem::Get()->ReadToString(path);
+
+			auto data = std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(fileContent.data()), fileContent.size());
+			if (IsCooked(data, COOKED_LOCALIZATION_MAGIC)) {
+				if (!LoadCookedLocalization(data, &this->content)) {
+					DebugLog(LOG_ERROR, "Invalid cooked localization: " << path, false);
+				}
+				return;
+			}
+
 			this->LoadString(fileContent);
 		}
 
+		/// Load the file again, after it changed on disk.
+		void Reload() {
+			if (this->filePath.empty()) {
+				return;
+			}
+			this->content.clear();
+			this->LoadFile(this->filePath);
+		}
+
 		void LoadString(std::string content) {
 			std::string buffer;
 			for (auto & c: content) {
@@ -182,6 +202,8 @@ namespace PrettyEngine {
 		}
 
 		void SetLangIndex(int newLangIndex) { this->lastLangIndex = newLangIndex; }
+
+		const std::string& GetFilePath() const { return this->filePath; }
 		
 	private:
 		int lastLangIndex = 0;
@@ -0,0 +1,77 @@
+#ifndef HPP_MAPPED_FILE
+#define HPP_MAPPED_FILE
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace PrettyEngine {
+	/// Read-only view of a whole file, memory mapped when the platform allow it or read in one go otherwise.
+	/// The data stay valid as long as the MappedFile is alive.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+
+		MappedFile(const std::string& path) { this->Open(path); }
+
+		~MappedFile() { this->Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept { this->MoveFrom(&other); }
+
+		MappedFile& operator=(MappedFile&& other) noexcept {
+			if (this != &other) {
+				this->Close();
+				this->MoveFrom(&other);
+			}
+			return *this;
+		}
+
+		bool Open(const std::string& path);
+
+		void Close();
+
+		bool Valid() const { return this->_valid; }
+
+		/// True if the data are mapped, false if they were copied by the fallback.
+		bool Mapped() const { return this->_mapped; }
+
+		std::span<const unsigned char> GetData() const { return std::span<const unsigned char>(this->_data, this->_size); }
+
+		size_t GetSize() const { return this->_size; }
+
+		std::vector<unsigned char> ToVector() const { return std::vector<unsigned char>(this->_data, this->_data + this->_size); }
+
+	private:
+		bool ReadFallback(const std::string& path);
+
+		void MoveFrom(MappedFile* other) {
+			this->_data = other->_data;
+			this->_size = other->_size;
+			this->_valid = other->_valid;
+			this->_mapped = other->_mapped;
+			this->_buffer = std::move(other->_buffer);
+
+			if (!this->_mapped) {
+				this->_data = this->_buffer.data();
+			}
+
+			other->_data = nullptr;
+			other->_size = 0;
+			other->_valid = false;
+			other->_mapped = false;
+		}
+
+	private:
+		const unsigned char* _data = nullptr;
+		size_t _size = 0;
+		bool _valid = false;
+		bool _mapped = false;
+		std::vector<unsigned char> _buffer;
+	};
+}
+
+#endif
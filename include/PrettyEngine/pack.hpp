@@ -0,0 +1,126 @@
+#ifndef H_PACK
+#define H_PACK
+
+#include <PrettyEngine/mappedFile.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Pack layout, every value is little-endian:
+/// - header: magic, version, entry count, reserved, index offset (u64), names offset (u64).
+/// - data: the content of each entry, aligned on PACK_ALIGNMENT.
+/// - index: one PACK_INDEX_ENTRY_SIZE record per entry sorted by hash (hash, offset, size, original size, name offset, name size, compression, reserved).
+/// - names: the paths of the entries, one after the other.
+#define PACK_MAGIC "PEPK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 16
+#define PACK_HEADER_SIZE 32
+#define PACK_INDEX_ENTRY_SIZE 48
+
+namespace PrettyEngine {
+	enum class PackCompression: uint32_t {
+		Stored = 0,
+		Zlib = 1,
+	};
+
+	struct PackEntry {
+	public:
+		uint64_t hash = 0;
+		uint64_t offset = 0;
+		/// Size in the pack.
+		uint64_t size = 0;
+		/// Size once decompressed.
+		uint64_t originalSize = 0;
+		std::string_view name;
+		PackCompression compression = PackCompression::Stored;
+	};
+
+	/// FNV-1a 64 of a path, the key of the pack index.
+	static constexpr uint64_t PackHash(std::string_view path) {
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (auto character: path) {
+			hash ^= static_cast<unsigned char>(character);
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	/// Path as stored in a pack: forward slashes and no leading "./" or "/".
+	static std::string NormalizePackPath(std::string_view path) {
+		std::string out(path);
+		for (auto & character: out) {
+			if (character == '\\') {
+				character = '/';
+			}
+		}
+		while (out.starts_with("./")) {
+			out.erase(0, 2);
+		}
+		while (out.starts_with("/")) {
+			out.erase(0, 1);
+		}
+		return out;
+	}
+
+	/// Read-only archive mapped in memory, made by tools/pack or PackWriter.
+	class PackFile {
+	public:
+		PackFile() = default;
+
+		PackFile(const std::string& path) { this->Open(path); }
+
+		bool Open(const std::string& path);
+
+		void Close() {
+			this->_file.Close();
+			this->_entries.clear();
+		}
+
+		bool Valid() const { return this->_file.Valid(); }
+
+		const PackEntry* Find(std::string_view path) const;
+
+		bool Contains(std::string_view path) const { return this->Find(path) != nullptr; }
+
+		/// Content of an entry as it is in the pack, compressed or not. Stay valid while the pack is open.
+		std::span<const unsigned char> GetRaw(const PackEntry* entry) const;
+
+		/// Decompress an entry if needed, return false if it is missing or corrupted.
+		bool Read(std::string_view path, std::vector<unsigned char>* out) const;
+
+		bool Read(const PackEntry* entry, std::vector<unsigned char>* out) const;
+
+		const std::vector<PackEntry>& GetEntries() const { return this->_entries; }
+
+	private:
+		MappedFile _file;
+		/// Sorted by hash.
+		std::vector<PackEntry> _entries;
+	};
+
+	/// Build a pack in memory, mostly for tests and the editor, tools/pack produce the same format.
+	class PackWriter {
+	public:
+		/// Zlib is only kept if it save at least minimumSaving of the size, already compressed files are stored.
+		void Add(std::string_view path, std::span<const unsigned char> data, bool compress = true, float minimumSaving = 0.1f);
+
+		bool Write(const std::string& path) const;
+
+		std::vector<unsigned char> Build() const;
+
+	private:
+		struct Pending {
+			std::string name;
+			std::vector<unsigned char> data;
+			uint64_t originalSize;
+			PackCompression compression;
+		};
+
+		std::vector<Pending> _pending;
+	};
+}
+
+#endif
@@ -4,9 +4,12 @@
 #include <PrettyEngine/debug/debug.hpp>
 #include <PrettyEngine/localization.hpp>
 #include <PrettyEngine/utils.hpp>
+#include <PrettyEngine/render/uniforms.hpp>
 
 #include <glad/glad.h>
 
+#include <array>
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <iostream>
@@ -43,9 +46,29 @@ namespace PrettyEngine {
 	public:
 		unsigned int shaderProgram;
 
+		/// Location of each Uniform, -1 as unsigned when the program does not use it.
+		std::array<unsigned int, static_cast<size_t>(Uniform::Count)> uniformLocations;
+
+		/// Uniforms by name, for the ones created by render features. Also hold the builtin ones under their uniforms.csv key.
 		std::unordered_map<std::string, unsigned int> uniforms;
 
 	public:
+		GLShaderProgramRefs() {
+			this->uniformLocations.fill(static_cast<unsigned int>(-1));
+		}
+
+		unsigned int GetUniform(Uniform uniform) const {
+			return this->uniformLocations[static_cast<size_t>(uniform)];
+		}
+
+		/// Query the location of every builtin uniform, must be called once the program is linked.
+		void ResolveUniforms() {
+			for (size_t i = 0; i < this->uniformLocations.size(); i++) {
+				this->uniformLocations[i] = glGetUniformLocation(this->shaderProgram, uniformNames[i]);
+				this->uniforms.insert_or_assign(uniformKeys[i], this->uniformLocations[i]);
+			}
+		}
+
 		void CreateUniform(std::string keyName, std::string name) {
 			unsigned int id = glGetUniformLocation(this->shaderProgram, name.c_str());
 			this->uniforms.insert(std::make_pair(keyName, id));
@@ -56,7 +79,8 @@ namespace PrettyEngine {
 			for(auto & c: content) {
 				if (c != '\n') {
 					stringBuffer.push_back(c);
-				} else {
+				}
+				if (c == '\n' || &c == &content.back()) {
 					auto csv = ParseCSVLine(stringBuffer);
 					if (csv.size() > 1) {
 						this->CreateUniform(csv[0], csv[1]);
@@ -20,6 +20,9 @@ namespace PrettyEngine {
 		virtual void OnUniform(VisualObject* visualObject) {}
 		/// Called when rendering
 		virtual void OnRender(VisualObject* visualObject) {}
+		/// True when OnUniform and OnRender only read the state shared by an instanced draw (RenderQueue::SameInstanceState), they are then called with its first object only.
+		/// Instancing is disabled while a feature returns false.
+		virtual bool SupportInstancing() const { return false; }
 		
 	public:
 		std::vector<Light*>* lights;
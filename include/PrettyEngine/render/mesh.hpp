@@ -18,6 +18,16 @@ namespace PrettyEngine {
 		glm::vec2 textureCoord;
 	};
 
+	/// Per instance data of an instanced draw, read by the vertex shader from the attributes 3 to 8.
+	struct InstanceData {
+	public:
+		glm::mat4 model;
+		/// Base color, opacity in alpha.
+		glm::vec4 color;
+		int layer;
+		int padding[3];
+	};
+
  	/// Contain and manages a mesh.
 	class Mesh: public GCObject {
 	public:
@@ -55,6 +65,7 @@ namespace PrettyEngine {
 		    glDeleteBuffers(1, &vbo);
 		    glDeleteVertexArrays(1, &vao);
 		    glDeleteBuffers(1, &ebo);
+		    glDeleteBuffers(1, &instanceVbo);
 		}
 
 	public:
@@ -69,6 +80,11 @@ namespace PrettyEngine {
 		unsigned int vbo;
 		unsigned int ebo;
 
+		/// Attached to the vao with a divisor of 1, filled for each instanced draw. Never empty, the non-instanced draws read its first instance.
+		unsigned int instanceVbo = 0;
+		/// Number of InstanceData the instance buffer can hold.
+		size_t instanceCapacity = 0;
+
 		std::string name;
 	};
 
@@ -11,14 +11,22 @@
 #include <PrettyEngine/collider.hpp>
 #include <PrettyEngine/render/light.hpp>
 #include <PrettyEngine/render/RenderFeature.hpp>
+#include <PrettyEngine/render/renderQueue.hpp>
+#include <PrettyEngine/render/spriteBatch.hpp>
+#include <PrettyEngine/render/uniformBuffer.hpp>
 #include <PrettyEngine/assetManager.hpp>
+#include <PrettyEngine/assetCache.hpp>
+#include <PrettyEngine/cooked.hpp>
 
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
 #include <imgui.h>
 
+#include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -33,6 +41,19 @@ namespace PrettyEngine {
 	
 	typedef void (*UniformMaker)(VisualObject*, Camera*);
 
+	/// Image decoded by a worker thread and waiting to be sent to the GPU.
+	struct TextureUpload {
+	public:
+		std::string name;
+		std::shared_ptr<unsigned char> pixels;
+		int width = 0;
+		int height = 0;
+		TextureChannels channels = TextureChannels::RGBA;
+		/// Set instead of pixels for cooked textures, they point into the mapped source.
+		std::vector<CookedTextureLevel> levels;
+		AssetHandle source;
+	};
+
 	class Renderer {
 	public:
 		Renderer();
@@ -171,6 +192,27 @@ namespace PrettyEngine {
 			TextureChannels channels 
 		);
 
+		/// Return at once a texture showing a placeholder, the image is read and decoded on a worker thread
+		/// then uploaded by Draw. Must be called from the OpenGL thread.
+		Texture* AddTextureAsync(
+			std::string name,
+			AssetHandle asset,
+			TextureType textureType,
+			TextureWrap wrap,
+			TextureFilter filter,
+			TextureChannels channels
+		);
+
+		/// Read the file of a texture again and upload it in place, for files changed on disk.
+		/// Return false if the texture does not exist.
+		bool ReloadTexture(const std::string& name, AssetCache* assetCache);
+
+		/// Send the decoded textures to the GPU, at most maxTextureUploadsPerFrame per call.
+		void ProcessTextureUploads();
+
+		/// Number of textures still being read, decoded or waiting for upload, the failed ones are not counted.
+		size_t GetPendingTextureCount();
+
 		Texture* AddTextureFromData(
 			std::string name,
 			unsigned char* data,
@@ -239,11 +281,10 @@ namespace PrettyEngine {
 		}
 
 		std::pair<bool, Texture*> TextureExist(std::string& name) {
-			for (auto & texture: this->glTextures) {
-				if (texture.second.name == name) {
-					return std::make_pair(true, &texture.second);
-				}
- 			}
+			auto texture = this->glTextures.find(name);
+			if (texture != this->glTextures.end()) {
+				return std::make_pair(true, &texture->second);
+			}
  			return std::make_pair(false, nullptr);
 		}
 
@@ -404,6 +445,7 @@ namespace PrettyEngine {
         	return glfwGetWindowAttrib(this->_window, GLFW_ICONIFIED);
 		}
 
+		/// Called before each draw call, instancing is disabled while at least one uniform maker is added.
 		void AddUniformMake(UniformMaker uniformMaker) {
 			this->_uniformMakers.push_back(uniformMaker);
 		}
@@ -413,6 +455,16 @@ namespace PrettyEngine {
 			this->_renderFeatures.push_back(renderFeature);
 		}
 
+		/// Draw calls and binds of the last frame drawn.
+		const RenderStats& GetRenderStats() const {
+			return this->_renderStats;
+		}
+
+		/// Must be called by code binding programs, vertex arrays or textures in the middle of a camera pass, like VisualObject::OnDraw.
+		void InvalidateRenderState() {
+			this->_renderState.Reset();
+		}
+
 	private:
 		std::vector<GLFWimage> _glfwIcons;
 
@@ -448,6 +500,15 @@ namespace PrettyEngine {
 
 		std::unordered_map<std::string, Texture> glTextures;
 
+		/// Limit the time spent uploading textures each frame.
+		size_t maxTextureUploadsPerFrame = 4;
+
+		/// Draw the consecutive objects of the render queue sharing the same state with a single instanced draw call.
+		bool instancing = true;
+
+		/// Sprites to draw this frame, for Render components and immediate-mode 2D code.
+		SpriteBatch spriteBatch;
+
 	private:
 		std::vector<std::shared_ptr<RenderFeature>> _renderFeatures;
 
@@ -470,6 +531,28 @@ namespace PrettyEngine {
 
 		std::vector<UniformMaker> _uniformMakers;
 
+		/// Reused by every camera pass to keep its memory.
+		RenderQueue _renderQueue;
+		RenderStateCache _renderState;
+		RenderStats _renderStats;
+
+		/// Fill the instance buffer of a mesh, growing it when needed.
+		void UploadInstances(Mesh* mesh, const std::vector<InstanceData>& instances);
+
+		std::vector<InstanceData> _instances;
+
+		/// FrameData and CameraData blocks, the lights are uploaded by RF_Light.
+		UniformBuffer<FrameUniforms> _frameUniforms;
+		UniformBuffer<CameraUniforms> _cameraUniforms;
+
+		/// Read and decode a texture on a worker, the result is uploaded by ProcessTextureUploads.
+		void StartTextureLoad(const std::string& name, AssetHandle asset, TextureChannels channels);
+
+		std::mutex _textureUploadMutex;
+		std::deque<TextureUpload> _textureUploads;
+		/// Declared after the queue so the workers are joined before it is destroyed.
+		std::vector<std::future<void>> _textureLoads;
+
 		unsigned int _textVAO, _textVBO;
 
 		ImGuiContext* imGUIContext;
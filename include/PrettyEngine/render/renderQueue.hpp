@@ -0,0 +1,247 @@
+#ifndef H_RENDER_QUEUE
+#define H_RENDER_QUEUE
+
+#include <PrettyEngine/render/PrettyGL.hpp>
+#include <PrettyEngine/render/visualObject.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Bits of each field of a render key, from the most significant.
+#define RENDER_KEY_LAYER_BITS 8
+#define RENDER_KEY_PROGRAM_BITS 12
+#define RENDER_KEY_TEXTURE_BITS 14
+#define RENDER_KEY_MESH_BITS 12
+#define RENDER_KEY_DEPTH_BITS 16
+
+/// Texture units used by the renderer for the textures of a VisualObject.
+#define RENDER_TEXTURE_UNIT_BASE 0
+#define RENDER_TEXTURE_UNIT_TRANSPARENCY 1
+#define RENDER_TEXTURE_UNIT_NORMAL 3
+#define RENDER_TEXTURE_UNIT_COUNT 4
+
+namespace PrettyEngine {
+	/// A VisualObject to draw during a camera pass.
+	struct RenderItem {
+	public:
+		uint64_t key;
+		VisualObject* object;
+		const std::string* name;
+	};
+
+	/// Visible objects of a camera pass, drawn in the order of their keys.
+	/// Opaque objects are grouped by shader program, texture then mesh, so the state changes are as few as possible, and drawn front to back.
+	/// Translucent ones are drawn after the opaque ones of their layer, back to front, then grouped by state.
+	class RenderQueue {
+	public:
+		void Clear() {
+			this->items.clear();
+		}
+
+		void Add(uint64_t key, VisualObject* object, const std::string* name) {
+			this->items.push_back(RenderItem{key, object, name});
+		}
+
+		void Sort() {
+			std::sort(this->items.begin(), this->items.end(), [](const RenderItem& a, const RenderItem& b){
+				return a.key < b.key;
+			});
+		}
+
+		const std::vector<RenderItem>& GetItems() const {
+			return this->items;
+		}
+
+		size_t GetSize() const {
+			return this->items.size();
+		}
+
+		/// Layer, translucency, 2D or 3D, then the state and the depth in an order depending on the translucency.
+		/// depth is the distance to the camera divided by the far plane, clamped to [0, 1].
+		static uint64_t MakeKey(unsigned int layer, bool translucent, bool d3, unsigned int program, unsigned int texture, unsigned int mesh, float depth) {
+			uint64_t key = Field(layer, RENDER_KEY_LAYER_BITS);
+			key = (key << 1) | static_cast<uint64_t>(translucent);
+			key = (key << 1) | static_cast<uint64_t>(d3);
+
+			auto quantizedDepth = QuantizeDepth(depth);
+
+			if (translucent) {
+				// Farther first
+				key = (key << RENDER_KEY_DEPTH_BITS) | (Mask(RENDER_KEY_DEPTH_BITS) - quantizedDepth);
+				key = (key << RENDER_KEY_PROGRAM_BITS) | Field(program, RENDER_KEY_PROGRAM_BITS);
+				key = (key << RENDER_KEY_TEXTURE_BITS) | Field(texture, RENDER_KEY_TEXTURE_BITS);
+				key = (key << RENDER_KEY_MESH_BITS) | Field(mesh, RENDER_KEY_MESH_BITS);
+			} else {
+				key = (key << RENDER_KEY_PROGRAM_BITS) | Field(program, RENDER_KEY_PROGRAM_BITS);
+				key = (key << RENDER_KEY_TEXTURE_BITS) | Field(texture, RENDER_KEY_TEXTURE_BITS);
+				key = (key << RENDER_KEY_MESH_BITS) | Field(mesh, RENDER_KEY_MESH_BITS);
+				// Closer first, so the depth test reject the hidden fragments
+				key = (key << RENDER_KEY_DEPTH_BITS) | quantizedDepth;
+			}
+
+			return key;
+		}
+
+		/// True if b can be drawn in the same instanced draw call as a, only the transform, base color, opacity and layer may differ.
+		static bool SameInstanceState(const VisualObject* a, const VisualObject* b) {
+			return b->render && b->allowInstancing &&
+				a->renderModel->shaderProgram == b->renderModel->shaderProgram &&
+				a->renderModel->mesh == b->renderModel->mesh &&
+				a->renderModel->drawMode == b->renderModel->drawMode &&
+				a->renderModel->useTexture == b->renderModel->useTexture &&
+				a->renderModel->overrideProjection == b->renderModel->overrideProjection &&
+				a->renderModel->projection == b->renderModel->projection &&
+				a->textures == b->textures &&
+				a->d3 == b->d3 &&
+				a->screenObject == b->screenObject &&
+				a->wireFrame == b->wireFrame &&
+				a->useLight == b->useLight &&
+				a->lightLayer == b->lightLayer &&
+				a->sunLight == b->sunLight &&
+				a->sharedData == b->sharedData;
+		}
+
+		static unsigned int GetKeyLayer(uint64_t key) {
+			return static_cast<unsigned int>(key >> (64 - RENDER_KEY_LAYER_BITS));
+		}
+
+		static bool GetKeyTranslucent(uint64_t key) {
+			return (key >> (63 - RENDER_KEY_LAYER_BITS)) & 1;
+		}
+
+	private:
+		static constexpr uint64_t Mask(int bits) {
+			return (uint64_t(1) << bits) - 1;
+		}
+
+		/// GL names bigger than a field only lose grouping, never correctness.
+		static uint64_t Field(unsigned int value, int bits) {
+			return static_cast<uint64_t>(value) & Mask(bits);
+		}
+
+		static uint64_t QuantizeDepth(float depth) {
+			depth = std::clamp(depth, 0.0f, 1.0f);
+			return static_cast<uint64_t>(depth * static_cast<float>(Mask(RENDER_KEY_DEPTH_BITS)));
+		}
+
+	private:
+		std::vector<RenderItem> items;
+	};
+
+	/// Counters of the last frame drawn.
+	struct RenderStats {
+	public:
+		size_t drawCalls = 0;
+		/// Objects drawn by instanced draw calls.
+		size_t instancedObjects = 0;
+		size_t programBinds = 0;
+		size_t vertexArrayBinds = 0;
+		size_t textureBinds = 0;
+		/// Binds not sent to OpenGL because the state was already set.
+		size_t skippedBinds = 0;
+	};
+
+	/// Remember the bound OpenGL state so setting it again cost nothing.
+	/// Must be reset when something else may have changed the state, like ImGui or a framebuffer switch.
+	class RenderStateCache {
+	public:
+		void Reset() {
+			this->program = UINT_MAX;
+			this->vertexArray = UINT_MAX;
+			this->activeUnit = UINT_MAX;
+			this->textures.fill(UINT_MAX);
+			this->polygonMode = 0;
+			this->depthTest = -1;
+		}
+
+		void SetStats(RenderStats* newStats) {
+			this->stats = newStats;
+		}
+
+		void UseProgram(unsigned int newProgram) {
+			if (this->program == newProgram) {
+				this->Skip();
+				return;
+			}
+			glUseProgram(newProgram);
+			this->program = newProgram;
+			if (this->stats != nullptr) {
+				this->stats->programBinds++;
+			}
+		}
+
+		void BindVertexArray(unsigned int newVertexArray) {
+			if (this->vertexArray == newVertexArray) {
+				this->Skip();
+				return;
+			}
+			glBindVertexArray(newVertexArray);
+			this->vertexArray = newVertexArray;
+			if (this->stats != nullptr) {
+				this->stats->vertexArrayBinds++;
+			}
+		}
+
+		void BindTexture(unsigned int unit, unsigned int texture) {
+			if (unit < this->textures.size() && this->textures[unit] == texture) {
+				this->Skip();
+				return;
+			}
+			if (this->activeUnit != unit) {
+				glActiveTexture(GL_TEXTURE0 + unit);
+				this->activeUnit = unit;
+			}
+			glBindTexture(GL_TEXTURE_2D, texture);
+			if (unit < this->textures.size()) {
+				this->textures[unit] = texture;
+			}
+			if (this->stats != nullptr) {
+				this->stats->textureBinds++;
+			}
+		}
+
+		void SetPolygonMode(GLenum mode) {
+			if (this->polygonMode != mode) {
+				glPolygonMode(GL_FRONT_AND_BACK, mode);
+				this->polygonMode = mode;
+			}
+		}
+
+		void SetDepthTest(bool state) {
+			if (this->depthTest != static_cast<int>(state)) {
+				if (state) {
+					glEnable(GL_DEPTH_TEST);
+				} else {
+					glDisable(GL_DEPTH_TEST);
+				}
+				this->depthTest = static_cast<int>(state);
+			}
+		}
+
+	private:
+		void Skip() {
+			if (this->stats != nullptr) {
+				this->stats->skippedBinds++;
+			}
+		}
+
+	private:
+		unsigned int program = UINT_MAX;
+		unsigned int vertexArray = UINT_MAX;
+		unsigned int activeUnit = UINT_MAX;
+		std::array<unsigned int, RENDER_TEXTURE_UNIT_COUNT> textures = { UINT_MAX, UINT_MAX, UINT_MAX, UINT_MAX };
+		GLenum polygonMode = 0;
+		/// -1 when unknown.
+		int depthTest = -1;
+
+		RenderStats* stats = nullptr;
+	};
+}
+
+#endif
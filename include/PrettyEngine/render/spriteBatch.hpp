@@ -0,0 +1,128 @@
+#ifndef H_SPRITE_BATCH
+#define H_SPRITE_BATCH
+
+#include <PrettyEngine/render/PrettyGL.hpp>
+#include <PrettyEngine/render/renderQueue.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace PrettyEngine {
+	struct SpriteVertex {
+	public:
+		glm::vec3 position;
+		glm::vec4 color;
+		glm::vec2 textureCoord;
+	};
+
+	/// Draw many textured quads with a few draw calls, for the 2D content.
+	/// Sprites are submitted every frame, from Render components or game code, and written into a single streaming vertex buffer.
+	/// They are drawn with the visual objects of their layer, grouped by texture: inside a layer, sprites of the same texture keep their submission order
+	/// but sprites of different textures may be reordered, use layers or an atlas when the order matters.
+	/// Sprites are not lit and have no depth test.
+	class SpriteBatch {
+	public:
+		SpriteBatch() = default;
+
+		SpriteBatch(const SpriteBatch&) = delete;
+		SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+		/// Create the buffers and the shader program, must be called once the OpenGL context exist.
+		void Setup();
+		void Cleanup();
+
+		/// Quad of size 1 centered on the origin, transformed by model. uv is the top left then the bottom right texture coordinates, for atlas pages.
+		/// A texture of 0 draw the color only.
+		void Draw(
+			unsigned int texture,
+			const glm::mat4& model,
+			glm::vec4 color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f),
+			unsigned int layer = 0,
+			bool screen = false,
+			glm::vec4 uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)
+		);
+
+		/// Same without matrix, rotation is around Z in radians.
+		void Draw(
+			unsigned int texture,
+			glm::vec3 position,
+			glm::vec2 size,
+			float rotation = 0.0f,
+			glm::vec4 color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f),
+			unsigned int layer = 0,
+			bool screen = false,
+			glm::vec4 uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)
+		);
+
+		/// Start drawing for a camera, the sprites are sorted and uploaded by the first pass of the frame.
+		/// The camera is read from the CameraData block, updated by the renderer before the pass.
+		void BeginPass(
+			RenderStateCache* state,
+			RenderStats* stats,
+			const std::vector<unsigned int>* hiddenLayers
+		);
+
+		/// Draw the sprites of the layers below layer not drawn yet in this pass.
+		void DrawUntilLayer(unsigned int layer);
+
+		/// Draw the remaining sprites of the pass.
+		void EndPass();
+
+		/// Forget the submitted sprites, called by the renderer at the end of each frame.
+		void Clear();
+
+		size_t GetSpriteCount() const {
+			return this->_keys.size();
+		}
+
+	private:
+		/// Consecutive sorted sprites drawn by one draw call.
+		struct SpriteRun {
+		public:
+			unsigned int layer;
+			bool screen;
+			unsigned int texture;
+			size_t first;
+			size_t count;
+		};
+
+		void AddQuad(unsigned int texture, unsigned int layer, bool screen, const glm::vec3* corners, glm::vec4 color, glm::vec4 uv);
+
+		/// Sort the sprites, fill the vertex buffer and build the runs. Binds the vertex array through the state of the pass.
+		void Prepare();
+
+		void DrawRun(const SpriteRun& run);
+
+	private:
+		unsigned int _vao = 0;
+		unsigned int _vbo = 0;
+		unsigned int _ebo = 0;
+		unsigned int _program = 0;
+
+		int _screenUniform = -1;
+		int _useTextureUniform = -1;
+
+		/// Number of quads the index buffer can draw.
+		size_t _indexCapacity = 0;
+		/// Size in bytes of the vertex buffer.
+		size_t _vertexBufferSize = 0;
+
+		/// Layer, screen, texture then submission index of each sprite.
+		std::vector<uint64_t> _keys;
+		/// Four per sprite, in submission order.
+		std::vector<SpriteVertex> _vertices;
+		std::vector<SpriteVertex> _sortedVertices;
+		std::vector<SpriteRun> _runs;
+		bool _prepared = false;
+
+		/// State of the current pass.
+		RenderStateCache* _state = nullptr;
+		RenderStats* _stats = nullptr;
+		const std::vector<unsigned int>* _hiddenLayers = nullptr;
+		size_t _nextRun = 0;
+	};
+}
+
+#endif
@@ -50,6 +50,10 @@ namespace PrettyEngine {
 		TextureWrap wrap;
 		TextureFilter filter;
 		TextureType textureType;
+		/// False while an asynchronous texture still show its placeholder.
+		bool ready = true;
+		/// True if the image of an asynchronous texture could not be decoded, it keeps its placeholder until reloaded.
+		bool failed = false;
 	};
 }
 
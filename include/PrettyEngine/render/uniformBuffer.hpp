@@ -0,0 +1,95 @@
+#ifndef H_UNIFORM_BUFFER
+#define H_UNIFORM_BUFFER
+
+#include <PrettyEngine/render/PrettyGL.hpp>
+
+#include <glm/glm.hpp>
+
+/// Binding points of the uniform blocks, the same in every shader.
+#define UNIFORM_BUFFER_FRAME 0
+#define UNIFORM_BUFFER_CAMERA 1
+#define UNIFORM_BUFFER_LIGHTS 2
+
+/// Size of the light arrays of the LightsData block.
+#define UNIFORM_BUFFER_MAX_LIGHTS 100
+
+namespace PrettyEngine {
+	/// FrameData block, std140 layout.
+	struct FrameUniforms {
+	public:
+		/// Sun color, factor in w.
+		glm::vec4 sunLight;
+		float time;
+		int mainLayer;
+		int padding[2];
+	};
+
+	/// CameraData block, std140 layout.
+	struct CameraUniforms {
+	public:
+		glm::mat4 view;
+		glm::mat4 projection;
+		/// Color filter in xyz.
+		glm::vec4 colorFilter;
+	};
+
+	/// LightsData block, std140 layout. Every array element is a vec4 so the layout match the C++ one.
+	struct LightsUniforms {
+	public:
+		int lightsCount;
+		int padding[3];
+		/// Position, radius in w.
+		glm::vec4 position[UNIFORM_BUFFER_MAX_LIGHTS];
+		/// Color, factor in w.
+		glm::vec4 color[UNIFORM_BUFFER_MAX_LIGHTS];
+		/// Deferred factor, opacity factor effect, spot light cut off, 1 for a spot light.
+		glm::vec4 parameters[UNIFORM_BUFFER_MAX_LIGHTS];
+		/// Spot light direction.
+		glm::vec4 direction[UNIFORM_BUFFER_MAX_LIGHTS];
+		/// Light layer in x.
+		glm::ivec4 layer[UNIFORM_BUFFER_MAX_LIGHTS];
+	};
+
+	static_assert(sizeof(FrameUniforms) == 32);
+	static_assert(sizeof(CameraUniforms) == 144);
+	static_assert(sizeof(LightsUniforms) == 16 + 5 * 16 * UNIFORM_BUFFER_MAX_LIGHTS);
+
+	/// Uniform block shared by every shader program, bound once to its binding point and updated once per frame or pass.
+	template<typename T>
+	class UniformBuffer {
+	public:
+		/// Needs the OpenGL context.
+		void Create(unsigned int newBinding) {
+			this->binding = newBinding;
+
+			glGenBuffers(1, &this->buffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(T), nullptr, GL_DYNAMIC_DRAW);
+			glBindBufferBase(GL_UNIFORM_BUFFER, this->binding, this->buffer);
+		}
+
+		void Destroy() {
+			glDeleteBuffers(1, &this->buffer);
+			this->buffer = 0;
+		}
+
+		bool Valid() const {
+			return this->buffer != 0;
+		}
+
+		void Update(const T& data) {
+			glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(T), &data);
+		}
+
+		unsigned int GetBinding() const {
+			return this->binding;
+		}
+
+	private:
+		unsigned int buffer = 0;
+		unsigned int binding = 0;
+	};
+}
+
+#endif
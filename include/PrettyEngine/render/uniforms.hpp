@@ -0,0 +1,69 @@
+#pragma once
+
+// Generated from assets/ENGINE_BUILTIN/uniforms.csv by tools/generateFiles
+
+namespace PrettyEngine {
+	/// Uniforms resolved once when a shader program is linked, index of GLShaderProgramRefs::uniformLocations.
+	enum class Uniform {
+		Model,
+		BaseColor,
+		UseTexture,
+		UseTransparencyTexture,
+		UseNormal,
+		Layer,
+		Opacity,
+		OverrideCamera,
+		ObjectView,
+		ObjectProjection,
+		LightLayer,
+		UseLight,
+		UseSunLight,
+		UseInstancing,
+		TextureBase,
+		TransparencyTexture,
+		NormalTexture,
+		Count,
+	};
+
+	/// Name of each Uniform in the key of GLShaderProgramRefs::uniforms.
+	static const char* const uniformKeys[] = {
+		"Model",
+		"BaseColor",
+		"UseTexture",
+		"UseTransparencyTexture",
+		"UseNormal",
+		"Layer",
+		"Opacity",
+		"OverrideCamera",
+		"ObjectView",
+		"ObjectProjection",
+		"LightLayer",
+		"UseLight",
+		"UseSunLight",
+		"UseInstancing",
+		"TextureBase",
+		"TransparencyTexture",
+		"NormalTexture",
+	};
+
+	/// Name of each Uniform in the shaders.
+	static const char* const uniformNames[] = {
+		"model",
+		"baseColor",
+		"useTexture",
+		"useTransparencyTexture",
+		"useNormal",
+		"layer",
+		"opacity",
+		"overrideCamera",
+		"objectView",
+		"objectProjection",
+		"lightLayer",
+		"useLight",
+		"useSunLight",
+		"useInstancing",
+		"textureBase",
+		"transparencyTexture",
+		"normalTexture",
+	};
+}
@@ -139,6 +139,7 @@ namespace PrettyEngine {
 			return nullptr;
 		}
 
+		/// Called after the object is drawn. Changing the bound OpenGL state requires a call to Renderer::InvalidateRenderState.
 		virtual void OnDraw(void* renderer) {}
 		virtual void OnRendererRegister(void* renderer) {}
 		virtual void OnRendererUnRegister(void* renderer) {}
@@ -183,6 +184,9 @@ namespace PrettyEngine {
 
 		bool allowRenderCube = true;
 
+		/// Let the renderer draw this object with others sharing its state in a single draw call.
+		bool allowInstancing = true;
+
 		int lightLayer = 0;
 
 		bool sunLight = false;
@@ -0,0 +1,437 @@
+#ifndef H_ROLLBACK
+#define H_ROLLBACK
+
+#include <PrettyEngine/dynamicObject.hpp>
+#include <PrettyEngine/world.hpp>
+#include <PrettyEngine/entity.hpp>
+#include <PrettyEngine/collider.hpp>
+#include <PrettyEngine/PhysicalSpace.hpp>
+#include <PrettyEngine/serial.hpp>
+#include <PrettyEngine/transform.hpp>
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace PrettyEngine {
+	/// Compact state of a transform.
+	struct TransformState {
+	public:
+		glm::vec3 position;
+		glm::quat rotation;
+		glm::vec3 scale;
+
+		bool operator==(const TransformState& other) const = default;
+
+		static TransformState FromTransform(Transform* transform) {
+			return TransformState{transform->position, transform->rotation, transform->scale};
+		}
+
+		void ApplyTo(Transform* transform) const {
+			transform->position = this->position;
+			transform->rotation = this->rotation;
+			transform->SetScale(this->scale);
+		}
+	};
+
+	/// Compact state of a collider registered in the PhysicalSpace.
+	struct ColliderState {
+	public:
+		TransformState transform;
+		glm::vec3 velocity;
+
+		bool operator==(const ColliderState& other) const = default;
+	};
+
+	/// An object captured by a snapshot, the entity itself or one of its components.
+	struct SnapshotObject {
+	public:
+		std::weak_ptr<SerialObject> object;
+		/// Raw pointer used to detect layout changes, never dereferenced without locking object.
+		SerialObject* address = nullptr;
+		/// Only set for entities.
+		Transform* transform = nullptr;
+		/// Index of the first field of the object in the flat field list.
+		uint32_t firstField = 0;
+		uint32_t fieldCount = 0;
+	};
+
+	/// Order of the captured objects, shared by a keyframe and all the deltas based on it.
+	struct SnapshotLayout {
+	public:
+		std::vector<SnapshotObject> objects;
+		std::vector<uint32_t> transformObjects;
+		std::vector<Collider*> colliders;
+		uint32_t totalFields = 0;
+	};
+
+	/// State of the worlds at a given frame.
+	/// A keyframe contains the whole state, a delta only what changed since its keyframe.
+	struct WorldSnapshot {
+	public:
+		size_t frame = 0;
+
+		std::shared_ptr<SnapshotLayout> layout;
+		/// Null for keyframes.
+		std::shared_ptr<WorldSnapshot> keyframe;
+
+		/// Dense for keyframes, sparse (using the indices) for deltas.
+		std::vector<uint32_t> transformIndices;
+		std::vector<TransformState> transforms;
+
+		std::vector<uint32_t> fieldIndices;
+		std::vector<std::string> fields;
+
+		std::vector<uint32_t> colliderIndices;
+		std::vector<ColliderState> colliders;
+
+		bool IsKeyframe() const { return this->keyframe == nullptr; }
+
+		size_t GetMemoryUsage() const {
+			size_t out = sizeof(WorldSnapshot);
+			out += this->transformIndices.capacity() * sizeof(uint32_t);
+			out += this->transforms.capacity() * sizeof(TransformState);
+			out += this->fieldIndices.capacity() * sizeof(uint32_t);
+			out += this->colliderIndices.capacity() * sizeof(uint32_t);
+			out += this->colliders.capacity() * sizeof(ColliderState);
+			for (auto & field: this->fields) {
+				out += sizeof(std::string) + field.capacity();
+			}
+			return out;
+		}
+	};
+
+	/// Ring buffer of in-memory world snapshots, used for rollback and replays.
+	/// Only the state is restored: entities or components added after a capture are kept as they are.
+	class RollbackBuffer {
+	public:
+		explicit RollbackBuffer(size_t capacity = 120, size_t keyframeInterval = 30) {
+			this->SetCapacity(capacity, keyframeInterval);
+		}
+
+		/// Remove every snapshot and change the size of the ring.
+		void SetCapacity(size_t capacity, size_t keyframeInterval) {
+			this->Clear();
+			this->_capacity = capacity > 0 ? capacity : 1;
+			this->_keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+			this->_snapshots.resize(this->_capacity);
+		}
+
+		/// Capture the state of the worlds for the given frame.
+		void Capture(size_t frame, std::vector<std::shared_ptr<World>>* worlds, PhysicalSpace* physicalSpace = nullptr) {
+			auto layout = this->CreateLayout(worlds, physicalSpace);
+
+			auto snapshot = std::make_shared<WorldSnapshot>();
+			snapshot->frame = frame;
+
+			auto keyframe = this->_lastKeyframe;
+			bool needKeyframe = keyframe == nullptr
+				|| frame < keyframe->frame
+				|| frame - keyframe->frame >= this->_keyframeInterval
+				|| !SameLayout(keyframe->layout.get(), layout.get());
+
+			if (needKeyframe) {
+				snapshot->layout = layout;
+				this->CaptureKeyframe(snapshot.get());
+				this->_lastKeyframe = snapshot;
+			} else {
+				snapshot->layout = keyframe->layout;
+				snapshot->keyframe = keyframe;
+				this->CaptureDelta(snapshot.get());
+			}
+
+			this->_snapshots[frame % this->_capacity] = snapshot;
+			this->_latestFrame = frame;
+			this->_hasFrame = true;
+		}
+
+		/// Return true if the frame is still in the ring.
+		bool Contains(size_t frame) const {
+			auto & snapshot = this->_snapshots[frame % this->_capacity];
+			return snapshot != nullptr && snapshot->frame == frame;
+		}
+
+		/// Restore the state captured at the given frame.
+		bool Restore(size_t frame, PhysicalSpace* physicalSpace = nullptr) {
+			if (!this->Contains(frame)) {
+				DebugLog(LOG_WARNING, "Rollback frame not available: " << frame, false);
+				return false;
+			}
+
+			auto & snapshot = this->_snapshots[frame % this->_capacity];
+			auto layout = snapshot->layout.get();
+			auto keyframe = snapshot->IsKeyframe() ? snapshot.get() : snapshot->keyframe.get();
+
+			// Lock every object once, the expired ones are skipped
+			std::vector<std::shared_ptr<SerialObject>> objects;
+			objects.reserve(layout->objects.size());
+			for (auto & object: layout->objects) {
+				objects.push_back(object.object.lock());
+			}
+
+			for (size_t i = 0; i < layout->transformObjects.size(); i++) {
+				this->RestoreTransform(layout, &objects, i, keyframe->transforms[i]);
+			}
+			for (size_t i = 0; i < layout->objects.size(); i++) {
+				if (auto & object = objects[i]) {
+					auto & snapshotObject = layout->objects[i];
+					auto count = std::min<size_t>(snapshotObject.fieldCount, object->serialFields.size());
+					for (size_t field = 0; field < count; field++) {
+						object->serialFields[field].value = keyframe->fields[snapshotObject.firstField + field];
+					}
+				}
+			}
+
+			if (!snapshot->IsKeyframe()) {
+				for (size_t i = 0; i < snapshot->transformIndices.size(); i++) {
+					this->RestoreTransform(layout, &objects, snapshot->transformIndices[i], snapshot->transforms[i]);
+				}
+				for (size_t i = 0; i < snapshot->fieldIndices.size(); i++) {
+					this->RestoreField(layout, &objects, snapshot->fieldIndices[i], snapshot->fields[i]);
+				}
+			}
+
+			if (physicalSpace != nullptr && !layout->colliders.empty()) {
+				// Colliders can be removed from the physics between two frames
+				std::unordered_set<Collider*> registered;
+				for (auto & layer: *physicalSpace->GetAllLayers()) {
+					registered.insert(layer.second.begin(), layer.second.end());
+				}
+
+				std::vector<ColliderState> colliders = keyframe->colliders;
+				if (!snapshot->IsKeyframe()) {
+					for (size_t i = 0; i < snapshot->colliderIndices.size(); i++) {
+						colliders[snapshot->colliderIndices[i]] = snapshot->colliders[i];
+					}
+				}
+
+				for (size_t i = 0; i < layout->colliders.size(); i++) {
+					auto collider = layout->colliders[i];
+					if (registered.contains(collider)) {
+						colliders[i].transform.ApplyTo(collider);
+						collider->velocity = colliders[i].velocity;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		/// Remove the snapshots captured after the given frame.
+		void DropAfter(size_t frame) {
+			for (auto & snapshot: this->_snapshots) {
+				if (snapshot != nullptr && snapshot->frame > frame) {
+					snapshot.reset();
+				}
+			}
+
+			if (this->_lastKeyframe != nullptr && this->_lastKeyframe->frame > frame) {
+				this->_lastKeyframe.reset();
+				if (this->Contains(frame)) {
+					auto & snapshot = this->_snapshots[frame % this->_capacity];
+					this->_lastKeyframe = snapshot->IsKeyframe() ? snapshot : snapshot->keyframe;
+				}
+			}
+
+			if (this->_latestFrame > frame) {
+				this->_latestFrame = frame;
+			}
+		}
+
+		void Clear() {
+			for (auto & snapshot: this->_snapshots) {
+				snapshot.reset();
+			}
+			this->_lastKeyframe.reset();
+			this->_latestFrame = 0;
+			this->_hasFrame = false;
+		}
+
+		size_t GetLatestFrame() const { return this->_latestFrame; }
+
+		/// Return the oldest frame still in the ring.
+		size_t GetOldestFrame() const {
+			size_t oldest = this->_latestFrame;
+			while (oldest > 0 && this->_latestFrame - oldest + 1 < this->_capacity && this->Contains(oldest - 1)) {
+				oldest--;
+			}
+			return oldest;
+		}
+
+		bool Empty() const { return !this->_hasFrame; }
+
+		size_t GetCapacity() const { return this->_capacity; }
+
+		/// Approximation of the memory used by the snapshots, in bytes.
+		size_t GetMemoryUsage() const {
+			size_t out = 0;
+			std::unordered_set<const WorldSnapshot*> counted;
+			for (auto & snapshot: this->_snapshots) {
+				if (snapshot != nullptr) {
+					for (auto current: {snapshot.get(), snapshot->keyframe.get()}) {
+						if (current != nullptr && counted.insert(current).second) {
+							out += current->GetMemoryUsage();
+						}
+					}
+				}
+			}
+			return out;
+		}
+
+	private:
+		std::shared_ptr<SnapshotLayout> CreateLayout(std::vector<std::shared_ptr<World>>* worlds, PhysicalSpace* physicalSpace) {
+			auto layout = std::make_shared<SnapshotLayout>();
+
+			auto addObject = [&layout](std::shared_ptr<SerialObject> object, Transform* transform) {
+				SnapshotObject snapshotObject;
+				snapshotObject.object = object;
+				snapshotObject.address = object.get();
+				snapshotObject.transform = transform;
+				snapshotObject.firstField = layout->totalFields;
+				snapshotObject.fieldCount = static_cast<uint32_t>(object->serialFields.size());
+
+				if (transform != nullptr) {
+					layout->transformObjects.push_back(static_cast<uint32_t>(layout->objects.size()));
+				}
+
+				layout->totalFields += snapshotObject.fieldCount;
+				layout->objects.push_back(snapshotObject);
+			};
+
+			for (auto & world: *worlds) {
+				if (world == nullptr) {
+					continue;
+				}
+				for (auto & entity: world->entities) {
+					if (entity.second == nullptr) {
+						continue;
+					}
+					addObject(entity.second, entity.second->GetTransform());
+					for (auto & component: entity.second->components) {
+						addObject(component, nullptr);
+					}
+				}
+			}
+
+			if (physicalSpace != nullptr) {
+				for (auto & layer: *physicalSpace->GetAllLayers()) {
+					for (auto & collider: layer.second) {
+						layout->colliders.push_back(collider);
+					}
+				}
+			}
+
+			return layout;
+		}
+
+		static bool SameLayout(const SnapshotLayout* a, const SnapshotLayout* b) {
+			if (a->objects.size() != b->objects.size() || a->colliders != b->colliders) {
+				return false;
+			}
+			for (size_t i = 0; i < a->objects.size(); i++) {
+				if (a->objects[i].address != b->objects[i].address || a->objects[i].fieldCount != b->objects[i].fieldCount || a->objects[i].object.expired()) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void CaptureKeyframe(WorldSnapshot* snapshot) {
+			auto layout = snapshot->layout.get();
+
+			snapshot->transforms.reserve(layout->transformObjects.size());
+			for (auto & index: layout->transformObjects) {
+				snapshot->transforms.push_back(TransformState::FromTransform(layout->objects[index].transform));
+			}
+
+			snapshot->fields.reserve(layout->totalFields);
+			for (auto & object: layout->objects) {
+				for (auto & field: object.address->serialFields) {
+					snapshot->fields.push_back(field.value);
+				}
+			}
+
+			snapshot->colliders.reserve(layout->colliders.size());
+			for (auto & collider: layout->colliders) {
+				snapshot->colliders.push_back(ColliderState{TransformState::FromTransform(collider), collider->velocity});
+			}
+		}
+
+		void CaptureDelta(WorldSnapshot* snapshot) {
+			auto layout = snapshot->layout.get();
+			auto keyframe = snapshot->keyframe.get();
+
+			for (uint32_t i = 0; i < layout->transformObjects.size(); i++) {
+				auto state = TransformState::FromTransform(layout->objects[layout->transformObjects[i]].transform);
+				if (!(state == keyframe->transforms[i])) {
+					snapshot->transformIndices.push_back(i);
+					snapshot->transforms.push_back(state);
+				}
+			}
+
+			for (auto & object: layout->objects) {
+				for (uint32_t field = 0; field < object.fieldCount; field++) {
+					auto & value = object.address->serialFields[field].value;
+					if (value != keyframe->fields[object.firstField + field]) {
+						snapshot->fieldIndices.push_back(object.firstField + field);
+						snapshot->fields.push_back(value);
+					}
+				}
+			}
+
+			for (uint32_t i = 0; i < layout->colliders.size(); i++) {
+				auto collider = layout->colliders[i];
+				auto state = ColliderState{TransformState::FromTransform(collider), collider->velocity};
+				if (!(state == keyframe->colliders[i])) {
+					snapshot->colliderIndices.push_back(i);
+					snapshot->colliders.push_back(state);
+				}
+			}
+		}
+
+		void RestoreTransform(SnapshotLayout* layout, std::vector<std::shared_ptr<SerialObject>>* objects, size_t transformIndex, const TransformState& state) {
+			auto objectIndex = layout->transformObjects[transformIndex];
+			if ((*objects)[objectIndex] != nullptr) {
+				state.ApplyTo(layout->objects[objectIndex].transform);
+			}
+		}
+
+		void RestoreField(SnapshotLayout* layout, std::vector<std::shared_ptr<SerialObject>>* objects, size_t fieldIndex, const std::string& value) {
+			// Fields are sorted by object, so a binary search find the owner
+			size_t low = 0;
+			size_t high = layout->objects.size();
+			while (high - low > 1) {
+				size_t middle = (low + high) / 2;
+				if (layout->objects[middle].firstField <= fieldIndex) {
+					low = middle;
+				} else {
+					high = middle;
+				}
+			}
+
+			auto & object = (*objects)[low];
+			auto localIndex = fieldIndex - layout->objects[low].firstField;
+			if (object != nullptr && localIndex < object->serialFields.size()) {
+				object->serialFields[localIndex].value = value;
+			}
+		}
+
+	private:
+		std::vector<std::shared_ptr<WorldSnapshot>> _snapshots;
+		std::shared_ptr<WorldSnapshot> _lastKeyframe;
+
+		size_t _capacity = 1;
+		size_t _keyframeInterval = 1;
+
+		size_t _latestFrame = 0;
+		bool _hasFrame = false;
+	};
+}
+
+#endif
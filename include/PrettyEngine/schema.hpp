@@ -0,0 +1,85 @@
+#ifndef H_SCHEMA
+#define H_SCHEMA
+
+#include <PrettyEngine/serial.hpp>
+#include <PrettyEngine/debug/debug.hpp>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PrettyEngine {
+	struct SerialSchemaField {
+	public:
+		std::string type;
+		std::string name;
+		std::string defaultValue;
+		/// Used instead of the default value when set, for values unique to each object.
+		std::function<std::string()> defaultGenerator;
+	};
+
+	/// Upgrade an object from one version to the next one.
+	using SerialMigration = std::function<void(SerialObject*)>;
+
+	/// Fields of a serialized type and how to upgrade older versions of it.
+	class SerialSchema {
+	public:
+		SerialSchema(int newVersion) {
+			this->_version = newVersion;
+		}
+
+		SerialSchema& Field(std::string type, std::string name, std::string defaultValue) {
+			this->_fields.push_back(SerialSchemaField{type, name, defaultValue, nullptr});
+			return *this;
+		}
+
+		SerialSchema& Field(std::string type, std::string name, std::function<std::string()> defaultGenerator) {
+			this->_fields.push_back(SerialSchemaField{type, name, "", defaultGenerator});
+			return *this;
+		}
+
+		/// Register the migration from fromVersion to fromVersion + 1, objects saved before schemas are version 0.
+		SerialSchema& Migration(int fromVersion, SerialMigration migration) {
+			this->_migrations.insert_or_assign(fromVersion, migration);
+			return *this;
+		}
+
+		/// Bring the object to the current version, nothing is done when it is already up to date.
+		void Apply(SerialObject* object) const {
+			if (object->serialSchemaVersion == this->_version) {
+				return;
+			}
+
+			if (object->serialSchemaVersion > this->_version) {
+				DebugLog(LOG_WARNING, object->serialObjectName << " schema version " << object->serialSchemaVersion << " is newer than " << this->_version, false);
+			} else {
+				for (int version = object->serialSchemaVersion; version < this->_version; version++) {
+					auto migration = this->_migrations.find(version);
+					if (migration != this->_migrations.end()) {
+						migration->second(object);
+					}
+				}
+			}
+
+			for (auto & field: this->_fields) {
+				if (!object->ContainSerializedField(field.name)) {
+					object->AddSerializedField(field.type, field.name, field.defaultGenerator ? field.defaultGenerator() : field.defaultValue);
+				}
+			}
+
+			object->serialSchemaVersion = this->_version;
+		}
+
+		int GetVersion() const { return this->_version; }
+
+		const std::vector<SerialSchemaField>* GetFields() const { return &this->_fields; }
+
+	private:
+		int _version;
+		std::vector<SerialSchemaField> _fields;
+		std::unordered_map<int, SerialMigration> _migrations;
+	};
+}
+
+#endif
@@ -2,13 +2,18 @@
 #define H_SERIAL
 
 #include <PrettyEngine/debug/debug.hpp>
+#include <PrettyEngine/binary.hpp>
+#include <PrettyEngine/intern.hpp>
 
 #include <sstream>
 #include <toml++/toml.h>
 #include <Guid.hpp>
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <future>
 
 namespace PrettyEngine {
@@ -16,20 +21,52 @@ namespace PrettyEngine {
 	                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                 
 	enum class SerializationFormat {
 		Toml,
+		/// Little-endian with LEB128 lengths, string table followed by tagged length-prefixed records.
+		Binary,
+	};
+
+	static constexpr std::string_view SERIAL_BINARY_MAGIC = "PESB";
+	static constexpr uint8_t SERIAL_BINARY_VERSION = 1;
+
+	enum class SerialBinaryTag: uint8_t {
+		End = 0,
+		ObjectName,
+		ObjectUnique,
+		Field,
+		SchemaVersion,
+	};
+
+	/// Guess the format of serialized data using the binary magic.
+	static SerializationFormat DetectSerializationFormat(std::string_view input) {
+		if (input.substr(0, SERIAL_BINARY_MAGIC.size()) == SERIAL_BINARY_MAGIC) {
+			return SerializationFormat::Binary;
+		}
+		return SerializationFormat::Toml;
+	}
+
+	/// Slot returned when a field does not exist.
+	static constexpr size_t SERIAL_FIELD_NO_SLOT = static_cast<size_t>(-1);
+
+	/// Hash accepting any string type, to look up fields without allocating a key.
+	struct SerialKeyHash {
+	  public:
+		using is_transparent = void;
+
+		size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
 	};
 
 	struct SerializedField {
 	  public:
-		SerializedField(std::string newType, std::string newName, std::string newValue) { 
+		SerializedField(InternedString newType, InternedString newName, std::string newValue) { 
 			this->type = newType;
 			this->name = newName;
-			this->value = newValue;
+			this->value = std::move(newValue);
 		}
 
 		SerializedField() {}
 
-		std::string type;
-		std::string name;
+		InternedString type;
+		InternedString name;
 		std::string value;
 	};
 
@@ -38,17 +75,19 @@ namespace PrettyEngine {
 	public:
 		virtual void AddToToml(toml::table* table) { DebugLog(LOG_DEBUG, "To do", false); }
 		virtual void FromToml(toml::table* table) { DebugLog(LOG_DEBUG, "To do", false); }
+		virtual void AddToBinary(BinaryWriter* writer) { DebugLog(LOG_DEBUG, "To do", false); }
+		virtual bool FromBinary(BinaryReader* reader) { DebugLog(LOG_DEBUG, "To do", false); return false; }
 
-		void SetObjectSerializedName(std::string newName) {
+		void SetObjectSerializedName(InternedString newName) {
 			this->serialObjectName = newName;
 		}
 
-		void SetupSerial(std::string newObjectName, std::string newUnique) {
+		void SetupSerial(InternedString newObjectName, std::string newUnique) {
 			this->SetSerializedUnique(newUnique);
 			this->SetObjectSerializedName(newObjectName);
 		}
 
-		std::string GetObjectSerializedName() { return this->serialObjectName; }
+		const std::string& GetObjectSerializedName() { return this->serialObjectName; }
 		std::string GetObjectSerializedUnique() { return this->serialObjectUnique; }
 
 		void SetSerializedUnique(std::string newUnique) {
@@ -56,98 +95,293 @@ namespace PrettyEngine {
 		}
 
 		void AddSerializedField(SerializedField serializedField) {
-
 			if (!this->ContainSerializedField(serializedField.name)) {
-				this->serialFields.push_back(serializedField);
+				this->PushSerializedField(std::move(serializedField));
 			}
 		}
 
 		/// Reduce memory current use.
 		void OptimizeSerialization() { 
 			for (auto &serialField : this->serialFields) {
-				serialField.name.shrink_to_fit();
-				serialField.type.shrink_to_fit();
 				serialField.value.shrink_to_fit();
 			}
 
-			this->serialObjectName.shrink_to_fit();
 			this->serialObjectUnique.shrink_to_fit();
 
 			this->serialFields.shrink_to_fit();
 		}
 
-		void AddSerializedField(std::string newType, std::string newName, std::string newValue) { 
-			SerializedField serializedField(newType, newName, newValue);
-			return this->AddSerializedField(serializedField);
+		void AddSerializedField(InternedString newType, InternedString newName, std::string newValue) { 
+			SerializedField serializedField(newType, newName, std::move(newValue));
+			return this->AddSerializedField(std::move(serializedField));
 		}
 
-		SerializedField* GetSerializedField(std::string name) { 
-			for (auto &field : this->serialFields) {
-				if (field.name == name) {
-					return &field;
-				}
+		/// Return the slot of a field, it can be kept to avoid any lookup as long as it is read with ResolveSerializedField.
+		size_t GetSerializedFieldSlot(std::string_view name) const {
+			auto field = this->_serialFieldIndex.find(name);
+			if (field != this->_serialFieldIndex.end()) {
+				return field->second;
+			}
+			return SERIAL_FIELD_NO_SLOT;
+		}
+
+		SerializedField* GetSerializedFieldAt(size_t slot) {
+			if (slot < this->serialFields.size()) {
+				return &this->serialFields[slot];
 			}
 			return nullptr;
 		}
 
-		std::string GetSerializedFieldValue(std::string name) {
-			if (this->ContainSerializedField(name)) {
-				for (auto &serial : this->serialFields) {
-					if (serial.name == name) {
-						return serial.value;
-					} 
-				}
+		/// Field at a kept slot, the slot is looked up again if a removed field shifted it to another field.
+		SerializedField* ResolveSerializedField(size_t* slot, const InternedString& name) {
+			auto field = this->GetSerializedFieldAt(*slot);
+			if (field == nullptr || field->name != name) {
+				*slot = this->GetSerializedFieldSlot(name);
+				field = this->GetSerializedFieldAt(*slot);
 			}
-			return "";
+			return field;
+		}
+
+		SerializedField* GetSerializedField(std::string_view name) { 
+			return this->GetSerializedFieldAt(this->GetSerializedFieldSlot(name));
+		}
+
+		const std::string& GetSerializedFieldValue(std::string_view name) {
+			if (auto field = this->GetSerializedField(name)) {
+				return field->value;
+			}
+			return SerialEmptyString();
+		}
+
+		const std::string& GetSerilizedFiledType(std::string_view name) {
+			if (auto field = this->GetSerializedField(name)) {
+				return field->type;
+			}
+			return SerialEmptyString();
 		}
 
-		std::string GetSerilizedFiledType(std::string name) {
-			if (this->ContainSerializedField(name)) {
-				for (auto &serial : this->serialFields) {
-					if (serial.name == name) {
-						return serial.type;
+		bool ContainSerializedField(std::string_view name) const {
+			return this->_serialFieldIndex.contains(name);
+		}
+
+		/// Keep the slot of the field, do nothing if the new name is already used.
+		bool RenameSerializedField(std::string_view name, InternedString newName) {
+			auto slot = this->GetSerializedFieldSlot(name);
+			if (slot == SERIAL_FIELD_NO_SLOT || this->ContainSerializedField(newName)) {
+				return false;
+			}
+
+			this->serialFields[slot].name = newName;
+			this->RebuildSerialFieldIndex();
+			return true;
+		}
+
+		/// Shift the slots of the fields that come after the removed one, ResolveSerializedField finds them again.
+		bool RemoveSerializedField(std::string_view name) {
+			auto slot = this->GetSerializedFieldSlot(name);
+			if (slot == SERIAL_FIELD_NO_SLOT) {
+				return false;
+			}
+
+			this->serialFields.erase(this->serialFields.begin() + slot);
+			this->RebuildSerialFieldIndex();
+			return true;
+		}
+
+		/// Write the object directly into a toml table.
+		void SerializeInto(toml::table* out) {
+			out->insert_or_assign("ObjectName", this->serialObjectName.str());
+
+			if (this->serialObjectUnique.empty()) {
+				this->serialObjectUnique = xg::newGuid();
+			}
+
+			out->insert_or_assign("ObjectUnique", this->serialObjectUnique);
+
+			if (this->serialSchemaVersion > 0) {
+				out->insert_or_assign("SchemaVersion", this->serialSchemaVersion);
+			}
+
+			auto fieldTable = toml::table();
+			for(auto & field: this->serialFields) {
+				auto valueArray = toml::array();
+				valueArray.reserve(2);
+				valueArray.push_back(field.type.str());
+				valueArray.push_back(field.value);
+
+				fieldTable.insert_or_assign(field.name.view(), std::move(valueArray));
+			}
+
+			out->insert_or_assign("fields", std::move(fieldTable));
+		}
+
+		/// Read the object from an already parsed toml table.
+		void DeserializeFrom(const toml::table& in) {
+			this->serialObjectName = in["ObjectName"].value_or("Null");
+			this->serialObjectUnique = in["ObjectUnique"].value_or("Null");
+			this->serialSchemaVersion = in["SchemaVersion"].value_or(0);
+
+			if (this->serialObjectUnique.empty()) {
+				this->serialObjectUnique = xg::newGuid();
+			}
+
+			auto fields = in["fields"].as_table();
+			if (fields != nullptr) {
+				for(auto & field: *fields) {
+					if (field.second.is_array()) {
+						int index = 0;
+						auto fieldArray = field.second.as_array();
+						SerializedField serializedField;
+						serializedField.name = field.first.str();
+						for (auto & element: *fieldArray) {
+							auto value = element.value_or("null");
+
+							if (index == 0) {
+								serializedField.type = value;
+							} else if (index == 1) {
+								serializedField.value = value;
+							}
+
+							index++;
+						}
+						this->PushSerializedField(std::move(serializedField));
 					}
 				}
 			}
-			return "";
 		}
 
-		bool ContainSerializedField(std::string name) {
-			for (auto &serializedField : this->serialFields) {
-				if (name == serializedField.name) {
-					return true;
-				}
+		/// Write the object in the binary format.
+		void SerializeInto(BinaryWriter* out) {
+			if (this->serialObjectUnique.empty()) {
+				this->serialObjectUnique = xg::newGuid();
 			}
 
-			return false;
+			BinaryStringTable stringTable;
+			BinaryWriter records;
+			BinaryWriter record;
+
+			auto writeRecord = [&](SerialBinaryTag tag) {
+				records.WriteU8(static_cast<uint8_t>(tag));
+				records.WriteVarU32(static_cast<uint32_t>(record.Size()));
+				records.WriteBytes(record.buffer);
+				record.buffer.clear();
+			};
+
+			record.WriteVarU32(stringTable.Add(this->serialObjectName));
+			writeRecord(SerialBinaryTag::ObjectName);
+
+			record.WriteVarU32(stringTable.Add(this->serialObjectUnique));
+			writeRecord(SerialBinaryTag::ObjectUnique);
+
+			if (this->serialSchemaVersion > 0) {
+				record.WriteVarU32(static_cast<uint32_t>(this->serialSchemaVersion));
+				writeRecord(SerialBinaryTag::SchemaVersion);
+			}
+
+			for(auto & field: this->serialFields) {
+				record.WriteVarU32(stringTable.Add(field.type));
+				record.WriteVarU32(stringTable.Add(field.name));
+				record.WriteVarU32(stringTable.Add(field.value));
+				writeRecord(SerialBinaryTag::Field);
+			}
+
+			records.WriteU8(static_cast<uint8_t>(SerialBinaryTag::End));
+
+			out->WriteBytes(SERIAL_BINARY_MAGIC);
+			out->WriteU8(SERIAL_BINARY_VERSION);
+			stringTable.Write(out);
+			out->WriteBytes(records.buffer);
 		}
 
-		std::string Serialize(SerializationFormat serialFormat = SerializationFormat::Toml) {
-			if (serialFormat == SerializationFormat::Toml) {
-				auto out = toml::parse("");
+		/// Read the object from the binary format, unknown records are skipped.
+		bool DeserializeFrom(BinaryReader* in) {
+			std::string_view magic;
+			uint8_t version;
+			if (!in->ReadBytes(SERIAL_BINARY_MAGIC.size(), &magic) || magic != SERIAL_BINARY_MAGIC || !in->ReadU8(&version) || version > SERIAL_BINARY_VERSION) {
+				return false;
+			}
 
-				out.insert_or_assign("ObjectName", this->serialObjectName);
+			BinaryStringTable stringTable;
+			if (!stringTable.Read(in)) {
+				return false;
+			}
 
-				if (this->serialObjectUnique.empty()) {
-					this->serialObjectUnique = xg::newGuid();
+			auto readString = [&](auto* out) {
+				uint32_t index;
+				if (!in->ReadVarU32(&index)) {
+					return false;
+				}
+				if (auto string = stringTable.Get(index)) {
+					*out = *string;
+					return true;
+				}
+				return false;
+			};
+
+			uint8_t tag;
+			while (in->ReadU8(&tag) && tag != static_cast<uint8_t>(SerialBinaryTag::End)) {
+				uint32_t size;
+				if (!in->ReadVarU32(&size)) {
+					return false;
 				}
 
-				out.insert_or_assign("ObjectUnique", this->serialObjectUnique);
+				auto recordEnd = in->GetPosition() + size;
 
-				auto fieldTable = toml::table();
-				for(auto & field: this->serialFields) {
-					auto valueArray = toml::array();
-					valueArray.push_back(field.type);
-					valueArray.push_back(field.value);
+				switch (static_cast<SerialBinaryTag>(tag)) {
+					case SerialBinaryTag::ObjectName:
+						if (!readString(&this->serialObjectName)) {
+							return false;
+						}
+						break;
+					case SerialBinaryTag::ObjectUnique:
+						if (!readString(&this->serialObjectUnique)) {
+							return false;
+						}
+						break;
+					case SerialBinaryTag::Field: {
+						SerializedField serializedField;
+						if (!readString(&serializedField.type) || !readString(&serializedField.name) || !readString(&serializedField.value)) {
+							return false;
+						}
+						this->PushSerializedField(std::move(serializedField));
+						break;
+					}
+					case SerialBinaryTag::SchemaVersion: {
+						uint32_t version;
+						if (!in->ReadVarU32(&version)) {
+							return false;
+						}
+						this->serialSchemaVersion = static_cast<int>(version);
+						break;
+					}
+					default:
+						break;
+				}
 
-					fieldTable.insert_or_assign(field.name, valueArray);
+				if (in->GetPosition() > recordEnd || !in->Skip(recordEnd - in->GetPosition())) {
+					return false;
 				}
+			}
+
+			if (this->serialObjectUnique.empty()) {
+				this->serialObjectUnique = xg::newGuid();
+			}
+
+			return in->Valid();
+		}
 
-				out.insert_or_assign("fields", fieldTable);
+		std::string Serialize(SerializationFormat serialFormat = SerializationFormat::Toml) {
+			if (serialFormat == SerializationFormat::Toml) {
+				auto out = toml::table();
+				this->SerializeInto(&out);
 
 				std::stringstream result;
 				result << out;
 				return result.str();
+			} else if (serialFormat == SerializationFormat::Binary) {
+				BinaryWriter out;
+				this->SerializeInto(&out);
+				return std::move(out.buffer);
 			}
 		
 			return "";
@@ -156,43 +390,43 @@ namespace PrettyEngine {
 		void Deserialize(std::string input, SerializationFormat serialFormat = SerializationFormat::Toml) {
 			if (!input.empty() && serialFormat == SerializationFormat::Toml) {
 				auto out = toml::parse(input);
-
-				this->serialObjectName = out["ObjectName"].value_or("Null");
-				this->serialObjectUnique = out["ObjectUnique"].value_or("Null");
-
-				if (this->serialObjectUnique.empty()) {
-					this->serialObjectUnique = xg::newGuid();
+				this->DeserializeFrom(out);
+			} else if (!input.empty() && serialFormat == SerializationFormat::Binary) {
+				BinaryReader reader(input);
+				if (!this->DeserializeFrom(&reader)) {
+					DebugLog(LOG_ERROR, "Invalid binary serial data: " << this->serialObjectUnique, false);
 				}
+			}
+		}
+	private:
+		static const std::string& SerialEmptyString() {
+			static const std::string empty;
+			return empty;
+		}
 
-				auto fields = out["fields"].as_table();
-				if (fields != nullptr) {
-					for(auto & field: *fields) {
-						if (field.second.is_array()) {
-							int index = 0;
-							auto fieldArray = field.second.as_array();
-							SerializedField serializedField;
-							serializedField.name = field.first;
-							for (auto & element: *fieldArray) {
-								auto value = element.value_or("null");
-
-								if (index == 0) {
-									serializedField.type = value;
-								} else if (index == 1) {
-									serializedField.value = value;
-								}
-
-								index++;
-							}
-							this->serialFields.push_back(serializedField);
-						}
-					}
-				}
+		/// Duplicated names keep the slot of the first field, as the fields are looked up in order.
+		void PushSerializedField(SerializedField&& serializedField) {
+			this->_serialFieldIndex.emplace(serializedField.name.view(), this->serialFields.size());
+			this->serialFields.push_back(std::move(serializedField));
+		}
+
+		void RebuildSerialFieldIndex() {
+			this->_serialFieldIndex.clear();
+			for (size_t i = 0; i < this->serialFields.size(); i++) {
+				this->_serialFieldIndex.emplace(this->serialFields[i].name.view(), i);
 			}
 		}
+
 	public:
-		std::string serialObjectName;
+		InternedString serialObjectName;
 		std::string serialObjectUnique;
 		std::vector<SerializedField> serialFields;
+		/// Version of the schema the fields follow, 0 for objects saved before schemas.
+		int serialSchemaVersion = 0;
+
+	private:
+		/// Keys point to the interned field names.
+		std::unordered_map<std::string_view, size_t, SerialKeyHash, std::equal_to<>> _serialFieldIndex;
 	};
 }
 
@@ -8,11 +8,38 @@ static const char* SHADER_FRAGMENT_FRAGMENT = R"(#version 430
 in vec3 Color;
 in vec2 Texcoord;
 in vec4 Vertex;
+in vec4 BaseColor;
+flat in int Layer;
 
 out vec4 outColor;
 
-uniform float time;
-uniform vec3 baseColor;
+#define UNIFORM_ARRAY_SIZE 100
+
+// Shared by every object, updated once per frame or camera pass
+layout(std140, binding = 0) uniform FrameData {
+    // Color, factor in w
+    vec4 sunLight;
+    float time;
+    int mainLayer;
+};
+
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+layout(std140, binding = 2) uniform LightsData {
+    int lightsCount;
+    // Position, radius in w
+    vec4 lightsPosition[UNIFORM_ARRAY_SIZE];
+    // Color, factor in w
+    vec4 lightsColor[UNIFORM_ARRAY_SIZE];
+    // Deferred factor, opacity factor effect, spot light cut off, spot light
+    vec4 lightsParameters[UNIFORM_ARRAY_SIZE];
+    vec4 spotLightDirection[UNIFORM_ARRAY_SIZE];
+    ivec4 lightsLayer[UNIFORM_ARRAY_SIZE];
+};
 
 uniform int useTexture;
 uniform sampler2D textureBase;
@@ -23,63 +50,38 @@ uniform sampler2D transparencyTexture;
 uniform int useNormal;
 uniform sampler2D normalTexture;
 
-uniform int layer;
-uniform int mainLayer;
-
-uniform float opacity;
-
 uniform int useSunLight;
-uniform vec3 sunLightColor;
-uniform float sunLightFactor;
 
 uniform int useLight;
-uniform int lightsCount;
 uniform int lightLayer;
 
-#define UNIFORM_ARRAY_SIZE 100
-
-uniform int[UNIFORM_ARRAY_SIZE] lightsLayer;
-
-uniform vec3[UNIFORM_ARRAY_SIZE] lightsPosition;
-uniform vec3[UNIFORM_ARRAY_SIZE] lightsColor;
-uniform float[UNIFORM_ARRAY_SIZE] lightsFactor;
-uniform float[UNIFORM_ARRAY_SIZE] lightsRadius;
-uniform float[UNIFORM_ARRAY_SIZE] lightsDeferredFactor;
-uniform float[UNIFORM_ARRAY_SIZE] lightsOpacityFactorEffect;
-
-uniform int[UNIFORM_ARRAY_SIZE] spotLight;
-uniform vec3[UNIFORM_ARRAY_SIZE] spotLightDirection;
-uniform float[UNIFORM_ARRAY_SIZE] spotLightCutOff;
-
-uniform vec3 colorFilter;
-
 vec4 GetVertexLight() {
     vec4 lightOutColor = vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
     if (useSunLight != 0) {
-        lightOutColor = vec4(sunLightColor * sunLightFactor, 1.0f);
+        lightOutColor = vec4(sunLight.rgb * sunLight.a, 1.0f);
     }
 
     if (useLight != 0) {
         for (int i = 0; i < lightsCount; i++) {
-            if (lightsLayer[i] == lightLayer) {
-                float distance = distance(Vertex.xyz, lightsPosition[i]);
+            if (lightsLayer[i].x == lightLayer) {
+                float distance = distance(Vertex.xyz, lightsPosition[i].xyz);
 
-                float distanceRatio = clamp(1.0 - distance / lightsRadius[i], 0.0, 1.0);
+                float distanceRatio = clamp(1.0 - distance / lightsPosition[i].w, 0.0, 1.0);
                 float intensityReduction = smoothstep(0.0, 1.0, distanceRatio);
-                float adjustedFactor = lightsFactor[i] * intensityReduction * lightsDeferredFactor[i];
+                float adjustedFactor = lightsColor[i].a * intensityReduction * lightsParameters[i].x;
 
-                if (spotLight[i] != 0) {
-                    vec3 lightDirection = normalize(lightsPosition[i] - Vertex.xyz);
-                    float cosTheta = dot(lightDirection, normalize(-spotLightDirection[i]));
+                if (lightsParameters[i].w != 0.0) {
+                    vec3 lightDirection = normalize(lightsPosition[i].xyz - Vertex.xyz);
+                    float cosTheta = dot(lightDirection, normalize(-spotLightDirection[i].xyz));
 
-                    if (cosTheta > cos(spotLightCutOff[i])) {
-                        lightOutColor = vec4((vec3(1.0f, 1.0f, 1.0f) + lightOutColor.xyz) * lightsColor[i] * adjustedFactor, lightsOpacityFactorEffect[i]);
+                    if (cosTheta > cos(lightsParameters[i].z)) {
+                        lightOutColor = vec4((vec3(1.0f, 1.0f, 1.0f) + lightOutColor.xyz) * lightsColor[i].rgb * adjustedFactor, lightsParameters[i].y);
                     }
                 }
                 
-                if (spotLight[i] == 0 && distance < lightsRadius[i]) {
-                    lightOutColor = vec4((vec3(1.0f, 1.0f, 1.0f) + lightOutColor.xyz) * lightsColor[i] * adjustedFactor, lightsOpacityFactorEffect[i]);
+                if (lightsParameters[i].w == 0.0 && distance < lightsPosition[i].w) {
+                    lightOutColor = vec4((vec3(1.0f, 1.0f, 1.0f) + lightOutColor.xyz) * lightsColor[i].rgb * adjustedFactor, lightsParameters[i].y);
                 }
             }
         }
@@ -103,17 +105,17 @@ void main()
     }
 
     if (useTexture == 0) {
-        outColor = vec4(baseColor * Color, opacity) * lightOutColor;
+        outColor = vec4(BaseColor.rgb * Color, BaseColor.a) * lightOutColor;
     } else {
-        outColor = (texture(textureBase, Texcoord) * vec4(baseColor * Color, opacity)) * lightOutColor;
+        outColor = (texture(textureBase, Texcoord) * vec4(BaseColor.rgb * Color, BaseColor.a)) * lightOutColor;
     }
 
     if (useNormal == 1 && useLight == 1) {
         for(int i = 0; i < lightsCount; i++) {
-            if (lightsLayer[i] == lightLayer) {
+            if (lightsLayer[i].x == lightLayer) {
                 vec3 normalColor = texture(normalTexture, Texcoord).rgb;
 
-                vec3 lightDirection = normalize(lightsPosition[i] - Vertex.xyz);
+                vec3 lightDirection = normalize(lightsPosition[i].xyz - Vertex.xyz);
 
                 float diff = max(dot(normalColor, lightDirection), 0.0);
 
@@ -122,35 +124,135 @@ void main()
         }
     }
 
-    outColor *= vec4(outColor.xyz * colorFilter, outColor.w);
+    outColor *= vec4(outColor.xyz * colorFilter.rgb, outColor.w);
+}
+)";
+
+/// Generated shader variable from file
+static const char* SHADER_SPRITE_FRAGMENT = R"(#version 430
+
+in vec4 Color;
+in vec2 Texcoord;
+
+out vec4 outColor;
+
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+uniform int useTexture;
+uniform sampler2D textureBase;
+
+void main()
+{
+    if (useTexture == 0) {
+        outColor = Color;
+    } else {
+        outColor = texture(textureBase, Texcoord) * Color;
+    }
+
+    outColor *= vec4(outColor.xyz * colorFilter.rgb, outColor.w);
+}
+)";
+
+/// Generated shader variable from file
+static const char* SHADER_SPRITE_VERTEX = R"(#version 430
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texcoord;
+
+out vec4 Color;
+out vec2 Texcoord;
+
+// Shared with the visual objects, updated once per camera pass
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+// Screen sprites are already in clip space and ignore the camera
+uniform int screen;
+
+void main()
+{
+    Color = color;
+    Texcoord = texcoord;
+
+    if (screen != 0) {
+        gl_Position = vec4(position, 1.0);
+    } else {
+        gl_Position = proj * view * vec4(position, 1.0);
+    }
 }
 )";
 
 /// Generated shader variable from file
 static const char* SHADER_VERTEX_VERTEX = R"(#version 430
 
-in vec3 position;
-in vec3 color;
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 texcoord;
 
-in vec2 texcoord;
+// Per instance attributes, read instead of the uniforms when useInstancing is set
+layout(location = 3) in mat4 instanceModel;
+layout(location = 7) in vec4 instanceColor;
+layout(location = 8) in int instanceLayer;
 
 out vec3 Color;
 out vec2 Texcoord;
 out vec4 Vertex;
+out vec4 BaseColor;
+flat out int Layer;
 
-uniform float time;
+// Shared by every object, updated once per camera pass
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+uniform int useInstancing;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 proj;
+
+// Used instead of the camera for screen objects and objects with their own projection
+uniform int overrideCamera;
+uniform mat4 objectView;
+uniform mat4 objectProjection;
+
+uniform vec3 baseColor;
+uniform float opacity;
+uniform int layer;
 
 void main()
 {
+    mat4 objectModel = model;
+    BaseColor = vec4(baseColor, opacity);
+    Layer = layer;
+
+    if (useInstancing != 0) {
+        objectModel = instanceModel;
+        BaseColor = instanceColor;
+        Layer = instanceLayer;
+    }
+
+    mat4 cameraView = view;
+    mat4 cameraProjection = proj;
+
+    if (overrideCamera != 0) {
+        cameraView = objectView;
+        cameraProjection = objectProjection;
+    }
+
     Color = color;
     Texcoord = texcoord;
-    gl_Position = proj * view * model * vec4(position, 1.0);
+    gl_Position = cameraProjection * cameraView * objectModel * vec4(position, 1.0);
 
-    Vertex = model * vec4(position, 1.0);
+    Vertex = objectModel * vec4(position, 1.0);
 }
 )";
 
@@ -1,6 +1,8 @@
 #ifndef HPP_TAGS
 #define HPP_TAGS
 
+#include <PrettyEngine/intern.hpp>
+
 #include <string>
 #include <vector>
 
@@ -10,7 +12,13 @@ namespace PrettyEngine {
 	public:
 		Tagged() {}
 
-		bool HaveTag(std::string otherTag) { 
+		bool HaveTag(std::string_view otherTagName) { 
+			// A tag that was never interned can not be on any object.
+			InternedString otherTag;
+			if (!InternedString::Find(otherTagName, &otherTag)) {
+				return false;
+			}
+
 			for (auto &tag : this->_tags) {
 				if (tag == otherTag) {
 					return true;
@@ -20,11 +28,11 @@ namespace PrettyEngine {
 			return false;
 		}
 
-		void AddTag(std::string tag) {
+		void AddTag(InternedString tag) {
 			this->_tags.push_back(tag);	
 		}
 
-		void RemoveTag(std::string tag) {
+		void RemoveTag(InternedString tag) {
 			for (int i = 0; i < this->_tags.size(); i++) {
 				if (this->_tags[i] == tag) {
 					this->_tags.erase(this->_tags.begin() + i);
@@ -33,7 +41,7 @@ namespace PrettyEngine {
 		}
 		
 	private:
-		std::vector<std::string> _tags;
+		std::vector<InternedString> _tags;
 	};
 	}
 
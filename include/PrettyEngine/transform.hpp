@@ -73,6 +73,44 @@ namespace PrettyEngine {
 			}
 		}
 
+		/// Position, rotation and scale as 10 floats.
+		void AddToBinary(BinaryWriter* writer) override {
+			for (int i = 0; i < 3; i++) {
+				writer->WriteF32(this->position[i]);
+			}
+			for (int i = 0; i < 4; i++) {
+				writer->WriteF32(this->rotation[i]);
+			}
+			for (int i = 0; i < 3; i++) {
+				writer->WriteF32(this->scale[i]);
+			}
+		}
+
+		bool FromBinary(BinaryReader* reader) override {
+			glm::vec3 newPosition;
+			glm::quat newRotation;
+			glm::vec3 newScale;
+
+			for (int i = 0; i < 3; i++) {
+				reader->ReadF32(&newPosition[i]);
+			}
+			for (int i = 0; i < 4; i++) {
+				reader->ReadF32(&newRotation[i]);
+			}
+			for (int i = 0; i < 3; i++) {
+				reader->ReadF32(&newScale[i]);
+			}
+
+			if (!reader->Valid()) {
+				return false;
+			}
+
+			this->position = newPosition;
+			this->rotation = newRotation;
+			this->SetScale(newScale);
+			return true;
+		}
+
 		glm::mat4 GetTransformMatrix() {
 			auto result = glm::identity<glm::mat4>();
 
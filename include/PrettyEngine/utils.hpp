@@ -63,7 +63,7 @@ namespace PrettyEngine {
 	}
 
 	static std::string ReadFileToString(std::string path) {
-	    std::ifstream input_file(path);
+	    std::ifstream input_file(path, std::ios::binary);
 	    if (!input_file.is_open()) {
 	    	DebugLog(LOG_ERROR, "Could not open: " << path, true);
 	    	if (boxer::Selection::Yes == boxer::show("Failed to read file, retry ?", "Retry ?", boxer::Style::Question, boxer::Buttons::YesNo)) {
@@ -79,7 +79,7 @@ namespace PrettyEngine {
 
 	static bool WriteFileString(std::string path, std::string content) {
 		std::ofstream outFile;
-		outFile.open(path);
+		outFile.open(path, std::ios::binary);
 		if (outFile.is_open()) {
 
 			outFile << content;
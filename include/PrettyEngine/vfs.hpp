@@ -0,0 +1,226 @@
+#ifndef H_VFS
+#define H_VFS
+
+#include <PrettyEngine/mappedFile.hpp>
+#include <PrettyEngine/pack.hpp>
+#include <PrettyEngine/utils.hpp>
+
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Layers are searched from the highest priority, loose files override the pack so a game can be patched.
+#define VFS_PRIORITY_LOOSE 300
+#define VFS_PRIORITY_PACK 200
+#define VFS_PRIORITY_DATABASE 100
+#define VFS_PRIORITY_BUILTIN 0
+/// Files embedded in the executable are found under this path.
+#define VFS_BUILTIN_MOUNT "builtin/"
+
+namespace PrettyEngine {
+	/// Read-only content of a file opened through the VirtualFileSystem, mapped, borrowed or decompressed.
+	/// The data stay valid as long as the VirtualFile is alive.
+	class VirtualFile {
+	public:
+		VirtualFile() = default;
+
+		VirtualFile(const VirtualFile&) = delete;
+		VirtualFile& operator=(const VirtualFile&) = delete;
+
+		VirtualFile(VirtualFile&& other) noexcept { *this = std::move(other); }
+
+		/// The moved file is left invalid, like a MappedFile.
+		VirtualFile& operator=(VirtualFile&& other) noexcept {
+			if (this != &other) {
+				this->_valid = std::exchange(other._valid, false);
+				this->_useBuffer = std::exchange(other._useBuffer, false);
+				this->_mapped = std::move(other._mapped);
+				this->_buffer = std::move(other._buffer);
+				this->_view = std::exchange(other._view, {});
+				this->_owner = std::move(other._owner);
+			}
+			return *this;
+		}
+
+		static VirtualFile FromMapped(MappedFile&& mapped) {
+			VirtualFile out;
+			out._valid = mapped.Valid();
+			out._mapped = std::move(mapped);
+			return out;
+		}
+
+		static VirtualFile FromBuffer(std::vector<unsigned char>&& buffer) {
+			VirtualFile out;
+			out._valid = true;
+			out._useBuffer = true;
+			out._buffer = std::move(buffer);
+			return out;
+		}
+
+		/// View on memory kept alive by owner, or static memory if owner is null.
+		static VirtualFile FromView(std::span<const unsigned char> view, std::shared_ptr<const void> owner = nullptr) {
+			VirtualFile out;
+			out._valid = true;
+			out._view = view;
+			out._owner = owner;
+			return out;
+		}
+
+		bool Valid() const { return this->_valid; }
+
+		/// False if the data were copied to be decompressed or read.
+		bool Mapped() const { return !this->_useBuffer && (this->_owner != nullptr || this->_view.data() != nullptr || this->_mapped.Mapped()); }
+
+		std::span<const unsigned char> GetData() const {
+			if (this->_useBuffer) {
+				return this->_buffer;
+			}
+			if (this->_mapped.Valid()) {
+				return this->_mapped.GetData();
+			}
+			return this->_view;
+		}
+
+		size_t GetSize() const { return this->GetData().size(); }
+
+		std::vector<unsigned char> ToVector() const {
+			auto data = this->GetData();
+			return std::vector<unsigned char>(data.begin(), data.end());
+		}
+
+	private:
+		bool _valid = false;
+		bool _useBuffer = false;
+		MappedFile _mapped;
+		std::vector<unsigned char> _buffer;
+		std::span<const unsigned char> _view;
+		std::shared_ptr<const void> _owner;
+	};
+
+	/// A source of files, given paths relative to its mount point. Must be safe to use from any thread.
+	class VirtualFileLayer {
+	public:
+		virtual ~VirtualFileLayer() = default;
+
+		virtual bool Exists(const std::string& path) = 0;
+		virtual VirtualFile Open(const std::string& path) = 0;
+		virtual std::string GetName() = 0;
+	};
+
+	/// Loose files on the disk.
+	class DirectoryLayer: public VirtualFileLayer {
+	public:
+		/// An empty root use the paths as they are.
+		DirectoryLayer(std::string newRoot = "") { this->root = newRoot; }
+
+		bool Exists(const std::string& path) override { return FileExist(this->root + path); }
+		VirtualFile Open(const std::string& path) override { return VirtualFile::FromMapped(MappedFile(this->root + path)); }
+		std::string GetName() override { return "directory:" + this->root; }
+
+	private:
+		std::string root;
+	};
+
+	/// Entries of a pack file, the stored ones are read straight from the mapped pack.
+	class PackLayer: public VirtualFileLayer {
+	public:
+		PackLayer(const std::string& newPath) {
+			this->path = newPath;
+			this->pack = std::make_shared<PackFile>(newPath);
+		}
+
+		bool Valid() const { return this->pack->Valid(); }
+
+		bool Exists(const std::string& entryPath) override { return this->pack->Contains(entryPath); }
+		VirtualFile Open(const std::string& entryPath) override;
+		std::string GetName() override { return "pack:" + this->path; }
+
+	private:
+		std::string path;
+		std::shared_ptr<PackFile> pack;
+	};
+
+	/// Binary assets of the AssetDataBase, the directory of the path is the asset path and the file name the asset name.
+	class DataBaseLayer: public VirtualFileLayer {
+	public:
+		bool Exists(const std::string& path) override;
+		VirtualFile Open(const std::string& path) override;
+		std::string GetName() override { return "database"; }
+	};
+
+	/// Files embedded in the executable, the assets of ENGINE_BUILTIN and the ones added at runtime.
+	class BuiltinLayer: public VirtualFileLayer {
+	public:
+		/// The data must outlive the layer, they take priority over the embedded assets.
+		void Add(const std::string& path, std::span<const unsigned char> data);
+
+		bool Exists(const std::string& path) override;
+		VirtualFile Open(const std::string& path) override;
+		std::string GetName() override { return "builtin"; }
+
+	private:
+		std::shared_mutex mutex;
+		std::unordered_map<std::string, std::span<const unsigned char>> files;
+	};
+
+	/// Resolve a path through the layers mounted on its prefix, the highest priority first.
+	/// A path is looked up in the layers only once, then the layer holding it is remembered until the next Mount, Unmount or InvalidateResolution.
+	class VirtualFileSystem {
+	public:
+		/// Engine-wide instance, with the disk mounted at the root by default.
+		static VirtualFileSystem* Get();
+
+		/// Layer mounted on VFS_BUILTIN_MOUNT.
+		static std::shared_ptr<BuiltinLayer> GetBuiltinLayer();
+
+		/// Put the pack, if it can be opened, and the binary assets of the AssetDataBase under the public directory.
+		void MountPublic(const std::string& publicPath, const std::string& packPath);
+
+		void Mount(const std::string& mountPoint, std::shared_ptr<VirtualFileLayer> layer, int priority = 0);
+		void Unmount(VirtualFileLayer* layer);
+
+		bool Exists(const std::string& path);
+
+		VirtualFile Open(const std::string& path);
+
+		std::vector<unsigned char> Read(const std::string& path) { return this->Open(path).ToVector(); }
+
+		std::string ReadToString(const std::string& path);
+
+		/// Layer that hold a path, nullptr if none.
+		std::shared_ptr<VirtualFileLayer> Resolve(const std::string& path);
+
+		/// Forget the resolved paths, for when files are added or removed.
+		void InvalidateResolution();
+
+		size_t GetResolvedCount();
+
+	private:
+		struct Mounted {
+			std::string mountPoint;
+			std::shared_ptr<VirtualFileLayer> layer;
+			int priority;
+		};
+
+		struct Resolution {
+			std::shared_ptr<VirtualFileLayer> layer;
+			std::string relativePath;
+		};
+
+		bool ResolveUncached(const std::string& path, Resolution* out);
+		bool FindResolution(const std::string& path, Resolution* out);
+
+	private:
+		std::shared_mutex mutex;
+		/// Sorted by priority, the highest first.
+		std::vector<Mounted> layers;
+		std::unordered_map<std::string, Resolution> resolved;
+	};
+}
+
+#endif
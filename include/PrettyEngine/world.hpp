@@ -5,6 +5,7 @@
 #include "components.hpp"
 #include "custom.hpp"
 #include <PrettyEngine/EngineContent.hpp>
+#include <PrettyEngine/assetPrefetcher.hpp>
 #include <PrettyEngine/transform.hpp>
 #include <PrettyEngine/render/render.hpp>
 #include <PrettyEngine/collider.hpp>
@@ -13,6 +14,7 @@
 
 #include <glm/vec3.hpp>
 
+#include <algorithm>
 #include <unordered_map>
 #include <memory>
 #include <future>
@@ -40,43 +42,91 @@ namespace PrettyEngine {
 			out.open(filePath);
 
 			if (out.is_open()) {
-				auto base = toml::parse("");
-				base.insert_or_assign("meta", toml::table{});
-				base["meta"].as_table()->insert_or_assign("name", this->worldName);
+				auto base = toml::table();
 
-				base.insert_or_assign("entities", toml::table{});
+				this->dependencies.clear();
+
+				auto entitiesTable = toml::table();
 				for(auto & entity: this->entities) {
-					auto entitiesTable = base["entities"].as_table();
-					entitiesTable->insert_or_assign(entity.second->serialObjectUnique, toml::table{});
-					auto entityTable = (*entitiesTable)[entity.second->serialObjectUnique].as_table();
-					entityTable->insert_or_assign("name", entity.second->entityName);
-					entityTable->insert_or_assign("object", entity.second->serialObjectName);
+					auto entityTable = toml::table();
+					entityTable.insert_or_assign("name", entity.second->entityName.str());
+					entityTable.insert_or_assign("object", entity.second->serialObjectName.str());
 
-					entityTable->insert_or_assign("transform", toml::table{});
-					auto transformTable = (*entityTable)["transform"].as_table();
-					entity.second->GetTransform()->AddToToml(transformTable);
+					std::vector<std::string> entityDependencies;
+					entity.second->CollectAssetDependencies(&entityDependencies);
+					for(auto & component: entity.second->components) {
+						component->CollectAssetDependencies(&entityDependencies);
+					}
+					if (!entityDependencies.empty()) {
+						entityTable.insert_or_assign("dependencies", ToDependencyArray(&entityDependencies));
+						this->dependencies.insert(this->dependencies.end(), entityDependencies.begin(), entityDependencies.end());
+					}
 
-					entityTable->insert_or_assign("serial", toml::table(toml::parse(entity.second->Serialize(SerializationFormat::Toml))));
+					auto transformTable = toml::table();
+					entity.second->GetTransform()->AddToToml(&transformTable);
+					entityTable.insert_or_assign("transform", std::move(transformTable));
+
+					auto serialTable = toml::table();
+					entity.second->SerializeInto(&serialTable);
+					entityTable.insert_or_assign("serial", std::move(serialTable));
 
 					auto componentTable = toml::table();
 					for(auto & component: entity.second->components) {
-						componentTable.insert_or_assign(component->serialObjectUnique, toml::table(toml::parse(component->Serialize(SerializationFormat::Toml))));
+						auto componentSerial = toml::table();
+						component->SerializeInto(&componentSerial);
+						componentTable.insert_or_assign(component->serialObjectUnique, std::move(componentSerial));
 					}
-					entityTable->insert_or_assign("components", componentTable);
+					entityTable.insert_or_assign("components", std::move(componentTable));
+
+					entitiesTable.insert_or_assign(entity.second->serialObjectUnique, std::move(entityTable));
 				}
+				base.insert_or_assign("entities", std::move(entitiesTable));
+
+				// Every asset of the world in one place, so they can be prefetched before the entities are created.
+				auto metaTable = toml::table();
+				metaTable.insert_or_assign("name", this->worldName);
+				metaTable.insert_or_assign("dependencies", ToDependencyArray(&this->dependencies));
+				base.insert_or_assign("meta", std::move(metaTable));
+
 				out << base;
-				out.flush();
 				out.close();
+
+				// Hash what is on the disk, so the file watcher can tell this save from an outside change.
+				this->fileHash = std::hash<std::string>{}(this->worldAsset.ReadToString());
 			}
 		}
 
-		void Load() {
+		/// Load the entities of the world file, the assets it depends on are prefetched meanwhile if a prefetcher is given.
+		/// An invalid file is reported and the world keeps its current entities, return false in this case.
+		bool Load(AssetPrefetcher* prefetcher = nullptr) {
+			auto fileContent = this->worldAsset.ReadToString();
+
+			toml::parse_result parsedResult;
+			try {
+				parsedResult = toml::parse(fileContent);
+			} catch (const toml::parse_error& error) {
+				DebugLog(LOG_ERROR, "Invalid world file: " << this->worldAsset.GetFilePath() << " " << error.description() << " at line " << error.source().begin.line, false);
+				return false;
+			}
+
 			this->Clear();
+			this->fileHash = std::hash<std::string>{}(fileContent);
 
-			toml::parse_result parsedResult = toml::parse(this->worldAsset.ReadToString());
-			
 			this->worldName = parsedResult["meta"]["name"].value_or("World");
 
+			this->dependencies.clear();
+			if (auto dependencyArray = parsedResult["meta"]["dependencies"].as_array()) {
+				for (auto & dependency: *dependencyArray) {
+					if (auto path = dependency.value<std::string>()) {
+						this->dependencies.push_back(*path);
+					}
+				}
+			}
+
+			if (prefetcher != nullptr) {
+				prefetcher->Prefetch(this->dependencies);
+			}
+
 			if (parsedResult["entities"].is_table()) {
 				for (auto &entity : *parsedResult["entities"].as_table()) {
 					std::string newEntityObject = (*entity.second.as_table())["object"].value_or("undefined");
@@ -105,7 +155,7 @@ namespace PrettyEngine {
 											if (element.second.is_array()) {
 												auto array = element.second.as_array();
 												SerializedField serialField;
-												serialField.name = element.first;
+												serialField.name = element.first.str();
 
 												if (array->size() > 0) {
 													serialField.type = array->at(0).value_or("null");
@@ -137,10 +187,7 @@ namespace PrettyEngine {
 
 											auto component = GetCustomComponent(objectName);
 
-											std::stringstream ss;
-											ss << *element.second.as_table();
-
-											component->Deserialize(ss.str());
+											component->DeserializeFrom(*elementTable);
 											component->serialObjectName = component->GetObjectSerializedName();
 											component->serialObjectUnique = component->GetObjectSerializedUnique();
 											component->owner = newEntity.get();
@@ -172,6 +219,7 @@ namespace PrettyEngine {
 					}
 				}
 			}
+			return true;
 		}
 		
 		void Start() {
@@ -383,6 +431,19 @@ namespace PrettyEngine {
 			return &this->entities;
 		}
 
+	private:
+		/// Sorted without duplicates, so saving the same world twice give the same file.
+		static toml::array ToDependencyArray(std::vector<std::string>* values) {
+			std::sort(values->begin(), values->end());
+			values->erase(std::unique(values->begin(), values->end()), values->end());
+
+			toml::array out;
+			for (auto & value: *values) {
+				out.push_back(value);
+			}
+			return out;
+		}
+
 	public:
 		std::unordered_map<std::string, std::shared_ptr<Entity>> entities;
 
@@ -398,6 +459,12 @@ namespace PrettyEngine {
 
 		Asset worldAsset;
 
+		/// Hash of the file as last loaded or saved, to tell our own writes from external changes.
+		size_t fileHash = 0;
+
+		/// Public relative paths of the assets used by the entities, as last loaded or saved.
+		std::vector<std::string> dependencies;
+
 	public:
 		Collider simulationCollider = Collider();
 
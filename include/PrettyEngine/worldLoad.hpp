@@ -4,6 +4,8 @@
 #include <PrettyEngine/dynamicObject.hpp>
 #include <PrettyEngine/collider.hpp>
 #include <PrettyEngine/world.hpp>
+#include <PrettyEngine/assetPrefetcher.hpp>
+#include <PrettyEngine/rollback.hpp>
 #include <PrettyEngine/utils.hpp>
 #include <PrettyEngine/debug/debug.hpp>
 #include <PrettyEngine/transform.hpp>
@@ -46,6 +48,7 @@ namespace PrettyEngine {
 			for(auto & world: this->_worlds) {
 				world->Save();
 			}
+			AssetMetaRegistry::Flush();
 		}
 
   		void ClearWorldInstances() {
@@ -58,9 +61,21 @@ namespace PrettyEngine {
 		void LoadWorlds(bool forceLoad = false) {
 			int index = 0;
 			for(auto & world: this->_worlds) {
-				world->Load();
+				world->Load(&this->_prefetcher);
 			}
 		}
+
+		/// Cache the assets the worlds depend on are prefetched into, nothing is prefetched without one.
+		void SetAssetCache(AssetCache* assetCache) {
+			this->_prefetcher.SetCache(assetCache);
+		}
+
+		AssetPrefetcher* GetPrefetcher() { return &this->_prefetcher; }
+
+		/// Let the cache evict the prefetched assets, once the objects of the worlds hold their own references.
+		void ReleasePrefetchedAssets() {
+			this->_prefetcher.Release();
+		}
 		
 		std::vector<std::shared_ptr<World>>* GetWorlds() {
 			return &this->_worlds;
@@ -108,16 +123,72 @@ namespace PrettyEngine {
 			return out;
 		}
 
+		/// Load again the worlds whose file was changed by something else than SaveWorlds, return true if any was.
+		bool ReloadChangedWorlds(const FileWatcher* fileWatcher) {
+			bool reloaded = false;
+			for(auto & world: this->_worlds) {
+				if (fileWatcher->Changed(world->worldAsset.GetFilePath())) {
+					if (std::hash<std::string>{}(world->worldAsset.ReadToString()) != world->fileHash) {
+						DebugLog(LOG_DEBUG, "Reload changed world: " << world->worldName, false);
+						// A file saved halfway through an edit can be invalid, the world then stays as it was.
+						if (world->Load(&this->_prefetcher)) {
+							reloaded = true;
+						}
+					}
+				}
+			}
+
+			if (reloaded) {
+				this->_rollbackBuffer.Clear();
+			}
+			return reloaded;
+		}
+
 		// Reload the worlds
   		void Reload() {
    			for(auto & world: this->_worlds) {
-   				world->Clear();
-   				world->Load();
+   				world->Load(&this->_prefetcher);
    			}
+   			this->_rollbackBuffer.Clear();
   		}
 
+		/// Enable the capture of a snapshot of the worlds each frame.
+		void SetRollback(bool state, size_t capacity = 120, size_t keyframeInterval = 30) {
+			this->_rollbackEnabled = state;
+			this->_rollbackBuffer.SetCapacity(capacity, keyframeInterval);
+		}
+
+		bool RollbackEnabled() const { return this->_rollbackEnabled; }
+
+		/// Capture the current state of the worlds, return the frame of the snapshot.
+		size_t CaptureSnapshot(PhysicalSpace* physicalSpace = nullptr) {
+			this->_rollbackFrame++;
+			this->_rollbackBuffer.Capture(this->_rollbackFrame, &this->_worlds, physicalSpace);
+			return this->_rollbackFrame;
+		}
+
+		/// Restore the worlds as they were at the given frame, later snapshots are dropped.
+		bool Rollback(size_t frame, PhysicalSpace* physicalSpace = nullptr) {
+			if (this->_rollbackBuffer.Restore(frame, physicalSpace)) {
+				this->_rollbackBuffer.DropAfter(frame);
+				this->_rollbackFrame = frame;
+				return true;
+			}
+			return false;
+		}
+
+		size_t GetCurrentFrame() const { return this->_rollbackFrame; }
+
+		RollbackBuffer* GetRollbackBuffer() { return &this->_rollbackBuffer; }
+
 	private:
 		std::vector<std::shared_ptr<World>> _worlds;
+
+		AssetPrefetcher _prefetcher;
+
+		RollbackBuffer _rollbackBuffer;
+		size_t _rollbackFrame = 0;
+		bool _rollbackEnabled = false;
 	};
 }
 
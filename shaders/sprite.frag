@@ -0,0 +1,26 @@
+#version 430
+
+in vec4 Color;
+in vec2 Texcoord;
+
+out vec4 outColor;
+
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+uniform int useTexture;
+uniform sampler2D textureBase;
+
+void main()
+{
+    if (useTexture == 0) {
+        outColor = Color;
+    } else {
+        outColor = texture(textureBase, Texcoord) * Color;
+    }
+
+    outColor *= vec4(outColor.xyz * colorFilter.rgb, outColor.w);
+}
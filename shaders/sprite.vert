@@ -0,0 +1,30 @@
+#version 430
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texcoord;
+
+out vec4 Color;
+out vec2 Texcoord;
+
+// Shared with the visual objects, updated once per camera pass
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+// Screen sprites are already in clip space and ignore the camera
+uniform int screen;
+
+void main()
+{
+    Color = color;
+    Texcoord = texcoord;
+
+    if (screen != 0) {
+        gl_Position = vec4(position, 1.0);
+    } else {
+        gl_Position = proj * view * vec4(position, 1.0);
+    }
+}
@@ -1,25 +1,63 @@
 #version 430
 
-in vec3 position;
-in vec3 color;
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+layout(location = 2) in vec2 texcoord;
 
-in vec2 texcoord;
+// Per instance attributes, read instead of the uniforms when useInstancing is set
+layout(location = 3) in mat4 instanceModel;
+layout(location = 7) in vec4 instanceColor;
+layout(location = 8) in int instanceLayer;
 
 out vec3 Color;
 out vec2 Texcoord;
 out vec4 Vertex;
+out vec4 BaseColor;
+flat out int Layer;
 
-uniform float time;
+// Shared by every object, updated once per camera pass
+layout(std140, binding = 1) uniform CameraData {
+    mat4 view;
+    mat4 proj;
+    vec4 colorFilter;
+};
+
+uniform int useInstancing;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 proj;
+
+// Used instead of the camera for screen objects and objects with their own projection
+uniform int overrideCamera;
+uniform mat4 objectView;
+uniform mat4 objectProjection;
+
+uniform vec3 baseColor;
+uniform float opacity;
+uniform int layer;
 
 void main()
 {
+    mat4 objectModel = model;
+    BaseColor = vec4(baseColor, opacity);
+    Layer = layer;
+
+    if (useInstancing != 0) {
+        objectModel = instanceModel;
+        BaseColor = instanceColor;
+        Layer = instanceLayer;
+    }
+
+    mat4 cameraView = view;
+    mat4 cameraProjection = proj;
+
+    if (overrideCamera != 0) {
+        cameraView = objectView;
+        cameraProjection = objectProjection;
+    }
+
     Color = color;
     Texcoord = texcoord;
-    gl_Position = proj * view * model * vec4(position, 1.0);
+    gl_Position = cameraProjection * cameraView * objectModel * vec4(position, 1.0);
 
-    Vertex = model * vec4(position, 1.0);
+    Vertex = objectModel * vec4(position, 1.0);
 }
@@ -2,7 +2,9 @@
 #include <PrettyEngine/assetManager.hpp>
 
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace PrettyEngine {
 	void Asset::Initialize(std::string& publicRelativeFilePath) {
@@ -12,17 +14,20 @@ namespace PrettyEngine {
 		this->SetSerializedUnique(publicRelativeFilePath);
 
 		if (this->Exist()) {
-			this->CreateMeta();
+			// Read the meta first, so its values take priority over the defaults.
+			auto meta = AssetMetaRegistry::Get(this->GetMetaPath());
+			if (!meta.empty()) {
+				this->metaFormat = DetectSerializationFormat(meta);
+				this->Deserialize(meta, this->metaFormat);
+			}
 
-			this->AddSerializedField(SERIAL_TOKEN(bool), "exist", this->Exist() ? "true" : "false");
+			this->AddSerializedField(SERIAL_TOKEN(bool), "exist", "true");
 			this->AddSerializedField(SERIAL_TOKEN(std::string), "metaCreationDate", GetTimeAsString());
 			this->AddSerializedField(SERIAL_TOKEN(std::string), "local", "any");
 			this->AddSerializedField(SERIAL_TOKEN(bool), "used", "false");
 			this->AddSerializedField(SERIAL_TOKEN(std::string), "version", this->version.ToString());
 
-			if (this->HaveMeta()) {
-				this->Deserialize(ReadFileToString(this->GetMetaPath()), SerializationFormat::Toml);
-			}
+			this->GetSerializedField("exist")->value = "true";
 
 			this->SetObjectSerializedName("Asset");
 			this->SetSerializedUnique(publicRelativeFilePath);
@@ -35,80 +40,275 @@ namespace PrettyEngine {
 		this->OptimizeSerialization();
 	}
 
-	std::vector<unsigned char> Asset::Read() {
-		this->GetSerializedField("used")->value = "true";
+	void Asset::SyncMeta() {
+		// Only assets that existed when initialized have a meta.
+		if (this->ContainSerializedField("exist")) {
+			AssetMetaRegistry::Set(this->GetMetaPath(), this->Serialize(this->metaFormat));
+		}
+	}
+
+	VirtualFile Asset::Map() {
+		auto output = VirtualFileSystem::Get()->Open(this->GetFilePath());
 
-		std::ifstream input(this->GetFilePath(), std::ios::binary);
+		if (!output.Valid()) {
+			DebugLog(LOG_ERROR, "Failed to open: " << this->path, true);
+		}
+		return output;
+	}
 
-		std::vector<unsigned char> output;
+	struct AssetMetaEntry {
+		std::string content;
+		bool dirty = false;
+		bool onDisk = false;
+	};
 
-		if (input.is_open()) {
-			this->GetSerializedField("exist")->value = "true";
+	/// Set to false once the storage is destroyed, for assets that outlive it.
+	static bool assetMetaStorageAlive = false;
+
+	struct AssetMetaStorage {
+		AssetMetaStorage() { assetMetaStorageAlive = true; }
+
+		~AssetMetaStorage() {
+			// Last chance for metas changed after the final save.
+			AssetMetaRegistry::Flush();
+			assetMetaStorageAlive = false;
+		}
+
+		std::mutex mutex;
+		std::unordered_map<std::string, AssetMetaEntry> entries;
+	};
+
+	static AssetMetaStorage assetMetaStorage;
+
+	std::string AssetMetaRegistry::Get(const std::string& metaPath) {
+		auto vfs = VirtualFileSystem::Get();
+
+		if (!assetMetaStorageAlive) {
+			return vfs->ReadToString(metaPath);
+		}
+
+		std::lock_guard lock(assetMetaStorage.mutex);
+
+		auto entry = assetMetaStorage.entries.find(metaPath);
+		if (entry != assetMetaStorage.entries.end()) {
+			return entry->second.content;
+		}
+
+		// Shipped games may only have the metas in their pack.
+		AssetMetaEntry newEntry;
+		auto file = vfs->Open(metaPath);
+		if (file.Valid()) {
+			auto data = file.GetData();
+			newEntry.content.assign(reinterpret_cast<const char*>(data.data()), data.size());
+			newEntry.onDisk = true;
+		}
+
+		return assetMetaStorage.entries.insert_or_assign(metaPath, newEntry).first->second.content;
+	}
+
+	void AssetMetaRegistry::Set(const std::string& metaPath, std::string content) {
+		if (!assetMetaStorageAlive) {
+			WriteFileString(metaPath, content);
+			return;
+		}
+
+		std::lock_guard lock(assetMetaStorage.mutex);
+
+		auto & entry = assetMetaStorage.entries[metaPath];
+		if (entry.content != content || !entry.onDisk) {
+			entry.content = std::move(content);
+			entry.dirty = true;
+		}
+	}
+
+	size_t AssetMetaRegistry::Flush() {
+		// Set already wrote the metas directly once the storage is gone.
+		if (!assetMetaStorageAlive) {
+			return 0;
+		}
+
+		std::lock_guard lock(assetMetaStorage.mutex);
 
-			char buffer;
-			while (input.get(buffer)) {
-				output.push_back(buffer);
+		size_t written = 0;
+		for (auto & entry: assetMetaStorage.entries) {
+			if (!entry.second.dirty) {
+				continue;
 			}
 
-			input.close();
-		} else {
-			this->GetSerializedField("exist")->value = "false";
-			DebugLog(LOG_ERROR, "Failed to open: " << this->path, true);
+			if (WriteFileString(entry.first, entry.second.content)) {
+				entry.second.dirty = false;
+				entry.second.onDisk = true;
+				written++;
+			} else {
+				DebugLog(LOG_ERROR, "Failed to write meta file: " << entry.first, true);
+			}
 		}
-		return output;
+		return written;
 	}
 
-	static DataBase assetDataBase = DataBase(GetEnginePublicPath("assets.db", true));
-	static std::string tableName = "any";
+	size_t AssetMetaRegistry::GetDirtyCount() {
+		if (!assetMetaStorageAlive) {
+			return 0;
+		}
 
-	std::vector<SQLBlobData> AssetDataBase::GetBinary(std::string directory, std::string assetName) {
-		std::stringstream command;
+		std::lock_guard lock(assetMetaStorage.mutex);
+
+		size_t count = 0;
+		for (auto & entry: assetMetaStorage.entries) {
+			if (entry.second.dirty) {
+				count++;
+			}
+		}
+		return count;
+	}
+
+	static const std::string assetGetText = "SELECT text FROM \"any\" WHERE path = ?1 AND name = ?2";
+	static const std::string assetGetBinaryRow = "SELECT rowid, length(bin) FROM \"any\" WHERE path = ?1 AND name = ?2 AND typeof(bin) = 'blob'";
+	static const std::string assetSetText =
+		"INSERT INTO \"any\" (name, path, text, bin) VALUES (?2, ?1, ?3, '') "
+		"ON CONFLICT (path, name) DO UPDATE SET text = excluded.text";
+	static const std::string assetSetBinary =
+		"INSERT INTO \"any\" (name, path, text, bin) VALUES (?2, ?1, '', ?3) "
+		"ON CONFLICT (path, name) DO UPDATE SET bin = excluded.bin";
 
-		command << "SELECT CASE ";
-		command << "WHEN name = '" << assetName;
-		command << "' AND path = '" << directory << "' THEN bin ";
-    	command << "ELSE NULL END AS result ";
-    	command << "FROM " << tableName;
+	/// The index on (path, name) make each lookup a b-tree search instead of a table scan.
+	static void SetupAssetDataBase(DataBase* dataBase) {
+		dataBase->SetJournalMode(JournalMode::WAL);
+		dataBase->SetSynchronous(SynchronousLevel::Normal);
 
-		return assetDataBase.QuerySQLBlob(command.str());
+		dataBase->ExecuteSQL("CREATE TABLE IF NOT EXISTS \"any\" (name TEXT, path TEXT, text TEXT, bin BLOB)");
+
+		auto indexed = dataBase->QuerySQLInt("SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' AND name = 'any_path_name'");
+		if (!indexed.empty() && indexed.front() > 0) {
+			return;
+		}
+
+		// Databases created before the unique index may have several rows per asset, the last written one was the one in use.
+		SQLTransaction migration(dataBase);
+
+		auto duplicates = dataBase->QuerySQLInt("SELECT COUNT(*) FROM \"any\" WHERE rowid NOT IN (SELECT MAX(rowid) FROM \"any\" GROUP BY path, name)");
+		if (!duplicates.empty() && duplicates.front() > 0) {
+			DebugLog(LOG_WARNING, "Removing " << duplicates.front() << " outdated duplicated rows from the asset database, the last written row of each asset is kept", false);
+			dataBase->ExecuteSQL("DELETE FROM \"any\" WHERE rowid NOT IN (SELECT MAX(rowid) FROM \"any\" GROUP BY path, name)");
+		}
+
+		dataBase->ExecuteSQL("CREATE UNIQUE INDEX any_path_name ON \"any\" (path, name)");
+		migration.Commit();
 	}
 
-	std::vector<std::string> AssetDataBase::GetText(std::string directory, std::string assetName) {
-		std::stringstream command;
+	static DataBasePool assetDataBase = DataBasePool(GetEnginePublicPath("assets.db", true), SetupAssetDataBase);
 
-		command << "SELECT CASE ";
-		command << "WHEN name = '" << assetName;
-		command << "' AND path = '" << directory << "' THEN text ";
-    	command << "ELSE NULL END AS result ";
-    	command << "FROM " << tableName;
+	void AssetDataBase::SetReadOnly(bool readOnly) {
+		assetDataBase.SetReadOnly(readOnly);
+	}
 
-		return assetDataBase.QuerySQLText(command.str());
+	void AssetDataBase::BeginBatch() {
+		assetDataBase.BeginTransaction();
 	}
 
-	void AssetDataBase::SetText(std::string directory, std::string assetName, std::string text) {
-		auto exist = false;
-		for(auto & name: assetDataBase.QuerySQLText("SELECT name FROM " + tableName)) {
-			if (name == assetName) {
-				exist = true;
-				break;
-			}
+	void AssetDataBase::EndBatch() {
+		assetDataBase.CommitTransaction();
+	}
+
+	/// Row id and size of a binary asset, false if there is none.
+	static bool FindAssetBinary(DataBase* reader, const std::string& directory, const std::string& assetName, int64_t* rowid, int64_t* size) {
+		auto statement = reader->GetStatement(assetGetBinaryRow);
+		statement->Bind(1, directory).Bind(2, assetName);
+
+		auto found = statement->Step();
+		if (found) {
+			*rowid = statement->ColumnInt(0);
+			*size = statement->ColumnInt(1);
 		}
 
-		std::stringstream command;
+		statement->Reset();
+		return found;
+	}
+
+	std::vector<SQLBlobData> AssetDataBase::GetBinary(std::string directory, std::string assetName) {
+		std::vector<SQLBlobData> out;
 
-		if (exist) {
-			command << " UPDATE " << tableName;
-			command << " SET text = \"" << text << '\"';
-			command << " WHERE path = \"" << directory << '\"';
-			command << " AND name = \"" << assetName << '\"';
+		auto size = GetBinarySize(directory, assetName);
+		if (size < 0) {
+			return out;
 		}
-		else {
-			command << "INSERT INTO " << tableName << " VALUES ";
-			command << "(\"" + assetName + "\",";
-			command << "\"" + directory + "\",";
-			command << "\"" + text + "\", \"\")";
+
+		SQLBlobData data;
+		data.data.resize(static_cast<size_t>(size));
+		data.bytes = static_cast<int>(size);
+
+		if (ReadBinary(directory, assetName, 0, data.data)) {
+			out.push_back(std::move(data));
 		}
 
-		assetDataBase.ExecuteSQL(command.str());
+		return out;
+	}
+
+	int64_t AssetDataBase::GetBinarySize(const std::string& directory, const std::string& assetName) {
+		int64_t rowid, size;
+		if (!FindAssetBinary(assetDataBase.GetReader(), directory, assetName, &rowid, &size)) {
+			return -1;
+		}
+		return size;
+	}
+
+	bool AssetDataBase::ReadBinary(const std::string& directory, const std::string& assetName, size_t offset, std::span<unsigned char> out) {
+		auto reader = assetDataBase.GetReader();
+
+		int64_t rowid, size;
+		if (!FindAssetBinary(reader, directory, assetName, &rowid, &size)) {
+			return false;
+		}
+
+		if (offset > static_cast<size_t>(size) || static_cast<size_t>(size) - offset < out.size()) {
+			return false;
+		}
+
+		if (out.empty()) {
+			return true;
+		}
+
+		sqlite3_blob* blob;
+		if (sqlite3_blob_open(reader->GetHandle(), "main", "any", "bin", rowid, 0, &blob) != SQLITE_OK) {
+			DebugLog(LOG_ERROR, "Failed to open blob: " << directory << '/' << assetName, true);
+			return false;
+		}
+
+		auto result = sqlite3_blob_read(blob, out.data(), static_cast<int>(out.size()), static_cast<int>(offset));
+		sqlite3_blob_close(blob);
+
+		return result == SQLITE_OK;
+	}
+
+	std::vector<std::string> AssetDataBase::GetText(std::string directory, std::string assetName) {
+		std::vector<std::string> out;
+
+		auto statement = assetDataBase.GetReader()->GetStatement(assetGetText);
+		statement->Bind(1, directory).Bind(2, assetName);
+
+		if (statement->Step() && statement->ColumnType(0) == SQLITE_TEXT) {
+			out.push_back(std::string(statement->ColumnText(0)));
+		}
+
+		statement->Reset();
+		return out;
+	}
+
+	void AssetDataBase::SetText(std::string directory, std::string assetName, std::string text) {
+		assetDataBase.Write([&](DataBase* writer) {
+			auto statement = writer->GetStatement(assetSetText);
+			statement->Bind(1, directory).Bind(2, assetName).Bind(3, text);
+			statement->Step();
+			statement->Reset();
+		});
+	}
+
+	void AssetDataBase::SetBinary(std::string directory, std::string assetName, std::span<const unsigned char> data) {
+		assetDataBase.Write([&](DataBase* writer) {
+			auto statement = writer->GetStatement(assetSetBinary);
+			statement->Bind(1, directory).Bind(2, assetName).BindBlob(3, data.data(), data.size());
+			statement->Step();
+			statement->Reset();
+		});
 	}
 }
@@ -1,47 +1,15 @@
 #include <PrettyEngine/audio.hpp>
-
-#include <fstream>
+#include <PrettyEngine/vfs.hpp>
 
 namespace PrettyEngine {
 	static std::vector<unsigned char> ReadAudioFile(std::string fileName) {
-		std::ifstream fileStream(fileName, std::ios::binary);
-	    if (!fileStream.is_open()) {
+		auto file = VirtualFileSystem::Get()->Open(fileName);
+	    if (!file.Valid()) {
 	        DebugLog(LOG_ERROR, "Error opening file: " << fileName, true);
 	        std::exit(-1);
 	    }
 
-	    // Get the file size by seeking to the end and then telling the position
-	    fileStream.seekg(0, std::ios::end);
-	    std::streampos fileSize = fileStream.tellg();
-	    fileStream.seekg(0, std::ios::beg);
-
-	    // Allocate memory to store the file content
-	    unsigned char* fileContent = new unsigned char[fileSize];
-
-	    // Read the file content into the allocated memory
-	    fileStream.read(reinterpret_cast<char*>(fileContent), fileSize);
-
-	    std::vector<unsigned char> out;
-
-	    // Check if the file was read successfully
-	    if (!fileStream) {
-	        DebugLog(LOG_ERROR, "Error reading file: " << fileName, true);
-	        delete[] fileContent;
-	        std::exit(-1);
-	    } else {
-	    	// Close the file stream
-		    fileStream.close();
-
-		    for (int i = 0; i < fileSize; i++) {
-		    	out.push_back(fileContent[i]);
-		    }
-
-		    delete[] fileContent; 
-
-		    return out;
-	    }
-
-	    return out;
+	    return file.ToVector();
 	}
 
 	void AudioSource::LoadFrequency(float frequency, float duration, float sampleRate) {
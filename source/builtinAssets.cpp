@@ -0,0 +1,103 @@
+#include <PrettyEngine/builtinAssets.hpp>
+#include <PrettyEngine/debug/debug.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace PrettyEngine {
+	struct BuiltinAssetSlot {
+		std::once_flag loaded;
+		/// Null-terminated by std::string.
+		std::string content;
+	};
+
+	static std::atomic<size_t> builtinAssetLoadedCount = 0;
+
+	/// One slot per entry of the index, so decompressing an asset never lock the others.
+	static BuiltinAssetSlot* GetBuiltinAssetSlots() {
+		static auto slots = std::make_unique<BuiltinAssetSlot[]>(GetBuiltinAssetIndex().size());
+		return slots.get();
+	}
+
+	static const BuiltinAssetEntry* FindBuiltinAsset(std::string_view path) {
+		auto index = GetBuiltinAssetIndex();
+		auto found = std::lower_bound(index.begin(), index.end(), path, [](const BuiltinAssetEntry& entry, std::string_view value){
+			return std::string_view(entry.path) < value;
+		});
+
+		if (found == index.end() || std::string_view(found->path) != path) {
+			return nullptr;
+		}
+		return &*found;
+	}
+
+	static bool InflateBuiltinAsset(const BuiltinAssetEntry* entry, std::string* out) {
+		out->resize(entry->size);
+
+		z_stream stream = {};
+		// 16 tell zlib to expect a gzip header, that is what cmake write.
+		if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+			return false;
+		}
+
+		stream.next_in = const_cast<Bytef*>(entry->data);
+		stream.avail_in = static_cast<uInt>(entry->dataSize);
+		stream.next_out = reinterpret_cast<Bytef*>(out->data());
+		stream.avail_out = static_cast<uInt>(out->size());
+
+		auto result = inflate(&stream, Z_FINISH);
+		auto written = stream.total_out;
+		inflateEnd(&stream);
+
+		return result == Z_STREAM_END && written == entry->size;
+	}
+
+	static const std::string* LoadBuiltinAsset(std::string_view path) {
+		auto entry = FindBuiltinAsset(path);
+		if (entry == nullptr) {
+			return nullptr;
+		}
+
+		auto slot = &GetBuiltinAssetSlots()[entry - GetBuiltinAssetIndex().data()];
+		std::call_once(slot->loaded, [entry, slot]{
+			if (entry->compression == BUILTIN_ASSET_STORED) {
+				slot->content.assign(reinterpret_cast<const char*>(entry->data), entry->dataSize);
+			} else if (!InflateBuiltinAsset(entry, &slot->content)) {
+				slot->content.clear();
+				DebugLog(LOG_ERROR, "Corrupted builtin asset: " << entry->path, true);
+			}
+			builtinAssetLoadedCount++;
+		});
+		return &slot->content;
+	}
+
+	bool BuiltinAssetExists(std::string_view path) {
+		return FindBuiltinAsset(path) != nullptr;
+	}
+
+	std::span<const unsigned char> GetBuiltinAssetData(std::string_view path) {
+		auto content = LoadBuiltinAsset(path);
+		if (content == nullptr) {
+			return {};
+		}
+		return std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(content->data()), content->size());
+	}
+
+	const char* GetBuiltinAsset(std::string_view path) {
+		auto content = LoadBuiltinAsset(path);
+		if (content == nullptr) {
+			DebugLog(LOG_ERROR, "Missing builtin asset: " << path, false);
+			return "";
+		}
+		return content->c_str();
+	}
+
+	size_t GetBuiltinAssetLoadedCount() {
+		return builtinAssetLoadedCount;
+	}
+}
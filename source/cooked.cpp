@@ -0,0 +1,147 @@
+#include <PrettyEngine/cooked.hpp>
+#include <PrettyEngine/binary.hpp>
+#include <PrettyEngine/render/mesh.hpp>
+
+#include <bit>
+#include <cstring>
+
+namespace PrettyEngine {
+	static std::string_view AsStringView(std::span<const unsigned char> data) {
+		return std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+
+	/// Read the magic and version shared by every cooked format.
+	static bool ReadCookedHeader(BinaryReader* reader, const char* magic) {
+		std::string_view fileMagic;
+		uint32_t version;
+		return reader->ReadBytes(4, &fileMagic) && fileMagic == magic && reader->ReadU32(&version) && version == COOKED_VERSION;
+	}
+
+	bool CookedTexture::Load(std::span<const unsigned char> data) {
+		this->levels.clear();
+
+		BinaryReader reader(AsStringView(data));
+
+		uint32_t width, height, channels, levelCount;
+		if (!ReadCookedHeader(&reader, COOKED_TEXTURE_MAGIC) ||
+			!reader.ReadU32(&width) || !reader.ReadU32(&height) || !reader.ReadU32(&channels) || !reader.ReadU32(&levelCount)) {
+			return false;
+		}
+
+		// The levels are uploaded as GL_RGBA
+		if (channels != 4) {
+			return false;
+		}
+
+		for (uint32_t i = 0; i < levelCount; i++) {
+			uint64_t offset, size;
+			uint32_t levelWidth, levelHeight;
+			if (!reader.ReadU64(&offset) || !reader.ReadU64(&size) || !reader.ReadU32(&levelWidth) || !reader.ReadU32(&levelHeight)) {
+				this->levels.clear();
+				return false;
+			}
+
+			if (offset > data.size() || data.size() - offset < size || size != uint64_t(levelWidth) * levelHeight * channels) {
+				this->levels.clear();
+				return false;
+			}
+
+			CookedTextureLevel level;
+			level.width = static_cast<int>(levelWidth);
+			level.height = static_cast<int>(levelHeight);
+			level.pixels = data.subspan(offset, size);
+			this->levels.push_back(level);
+		}
+
+		this->channels = static_cast<int>(channels);
+		return !this->levels.empty();
+	}
+
+	bool LoadCookedMesh(std::span<const unsigned char> data, Mesh* out) {
+		BinaryReader reader(AsStringView(data));
+
+		uint32_t vertexCount, indexCount;
+		uint64_t vertexOffset, indexOffset;
+		if (!ReadCookedHeader(&reader, COOKED_MESH_MAGIC) ||
+			!reader.ReadU32(&vertexCount) || !reader.ReadU32(&indexCount) || !reader.ReadU64(&vertexOffset) || !reader.ReadU64(&indexOffset)) {
+			return false;
+		}
+
+		constexpr size_t vertexSize = 9 * sizeof(float);
+		if (vertexOffset > data.size() || (data.size() - vertexOffset) / vertexSize < vertexCount ||
+			indexOffset > data.size() || (data.size() - indexOffset) / sizeof(uint32_t) < indexCount) {
+			return false;
+		}
+
+		out->vertices.resize(vertexCount);
+		out->indices.resize(indexCount);
+
+		// The cooked layout is the one of Vertex, a single copy is enough on little-endian platforms.
+		if constexpr (std::endian::native == std::endian::little && sizeof(Vertex) == vertexSize && sizeof(unsigned int) == sizeof(uint32_t)) {
+			std::memcpy(out->vertices.data(), data.data() + vertexOffset, vertexCount * vertexSize);
+			std::memcpy(out->indices.data(), data.data() + indexOffset, indexCount * sizeof(uint32_t));
+		} else {
+			BinaryReader vertices(AsStringView(data.subspan(vertexOffset)));
+			for (auto & vertex: out->vertices) {
+				vertices.ReadF32(&vertex.position.x);
+				vertices.ReadF32(&vertex.position.y);
+				vertices.ReadF32(&vertex.position.z);
+				vertices.ReadF32(&vertex.color.r);
+				vertices.ReadF32(&vertex.color.g);
+				vertices.ReadF32(&vertex.color.b);
+				vertices.ReadF32(&vertex.color.a);
+				vertices.ReadF32(&vertex.textureCoord.x);
+				vertices.ReadF32(&vertex.textureCoord.y);
+			}
+
+			BinaryReader indices(AsStringView(data.subspan(indexOffset)));
+			for (auto & index: out->indices) {
+				uint32_t value;
+				indices.ReadU32(&value);
+				index = value;
+			}
+		}
+
+		out->vertexCount = static_cast<int>(vertexCount);
+		return true;
+	}
+
+	bool LoadCookedMeshAsset(const std::string& publicRelativePath, Mesh* out) {
+		auto path = FindCookedAsset(publicRelativePath, GetCookedExtension(publicRelativePath));
+
+		auto file = VirtualFileSystem::Get()->Open(path);
+		if (!file.Valid() || !IsCooked(file.GetData(), COOKED_MESH_MAGIC)) {
+			return false;
+		}
+		return LoadCookedMesh(file.GetData(), out);
+	}
+
+	bool LoadCookedLocalization(std::span<const unsigned char> data, std::vector<std::vector<std::string>>* out) {
+		BinaryReader reader(AsStringView(data));
+
+		uint32_t lineCount;
+		if (!ReadCookedHeader(&reader, COOKED_LOCALIZATION_MAGIC) || !reader.ReadU32(&lineCount)) {
+			return false;
+		}
+
+		std::vector<std::vector<std::string>> lines;
+		for (uint32_t i = 0; i < lineCount; i++) {
+			uint32_t columnCount;
+			if (!reader.ReadVarU32(&columnCount)) {
+				return false;
+			}
+
+			auto & line = lines.emplace_back();
+			for (uint32_t column = 0; column < columnCount; column++) {
+				std::string_view value;
+				if (!reader.ReadString(&value)) {
+					return false;
+				}
+				line.emplace_back(value);
+			}
+		}
+
+		*out = std::move(lines);
+		return true;
+	}
+}
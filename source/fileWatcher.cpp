@@ -0,0 +1,207 @@
+#include <PrettyEngine/fileWatcher.hpp>
+#include <PrettyEngine/debug/debug.hpp>
+
+#if defined(__linux__)
+	#define PRETTY_FILE_WATCHER_INOTIFY 1
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+namespace PrettyEngine {
+	FileWatcher::~FileWatcher() {
+#if PRETTY_FILE_WATCHER_INOTIFY
+		if (this->_notify >= 0) {
+			close(this->_notify);
+		}
+#endif
+	}
+
+	std::string FileWatcher::Normalize(std::string_view path) {
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+	bool FileWatcher::ChangedIn(std::string_view directory) const {
+		auto prefix = Normalize(directory);
+		if (!prefix.ends_with('/')) {
+			prefix.push_back('/');
+		}
+
+		for (auto & change: this->_changes) {
+			if (change.starts_with(prefix)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool FileWatcher::Watch(const std::string& directory) {
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error)) {
+			DebugLog(LOG_ERROR, "Can not watch missing directory: " << directory, false);
+			return false;
+		}
+
+		auto normalized = Normalize(directory);
+		if (normalized.ends_with('/')) {
+			normalized.pop_back();
+		}
+		this->_directories.push_back(normalized);
+
+#if PRETTY_FILE_WATCHER_INOTIFY
+		if (this->_notify < 0) {
+			this->_notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (this->_notify < 0) {
+				DebugLog(LOG_WARNING, "inotify not available, polling the files instead", false);
+			}
+		}
+
+		if (this->_notify >= 0) {
+			this->AddWatch(normalized);
+			for (auto & entry: std::filesystem::recursive_directory_iterator(normalized, error)) {
+				if (entry.is_directory(error)) {
+					this->AddWatch(Normalize(entry.path().string()));
+				}
+			}
+			return true;
+		}
+#endif
+
+		for (auto & entry: std::filesystem::recursive_directory_iterator(normalized, error)) {
+			if (entry.is_regular_file(error)) {
+				this->_snapshot[Normalize(entry.path().string())] = entry.last_write_time(error);
+			}
+		}
+		this->_lastPoll = std::chrono::steady_clock::now();
+		return true;
+	}
+
+	void FileWatcher::AddWatch(const std::string& directory) {
+#if PRETTY_FILE_WATCHER_INOTIFY
+		// Files are reported once written and closed, or moved in by editors saving through a temporary file.
+		auto descriptor = inotify_add_watch(this->_notify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_DELETE_SELF);
+		if (descriptor < 0) {
+			DebugLog(LOG_WARNING, "Failed to watch: " << directory, false);
+			return;
+		}
+		this->_watchDescriptors[descriptor] = directory;
+#endif
+	}
+
+	void FileWatcher::Touch(const std::string& path) {
+		this->_pending[path] = std::chrono::steady_clock::now();
+	}
+
+	void FileWatcher::ReadNotify() {
+#if PRETTY_FILE_WATCHER_INOTIFY
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		while (true) {
+			auto size = read(this->_notify, buffer, sizeof(buffer));
+			if (size <= 0) {
+				return;
+			}
+
+			for (ssize_t position = 0; position < size;) {
+				auto event = reinterpret_cast<inotify_event*>(buffer + position);
+				position += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_IGNORED) {
+					this->_watchDescriptors.erase(event->wd);
+					continue;
+				}
+
+				auto directory = this->_watchDescriptors.find(event->wd);
+				if (directory == this->_watchDescriptors.end() || event->len == 0) {
+					continue;
+				}
+
+				auto path = directory->second + '/' + event->name;
+
+				if (event->mask & IN_ISDIR) {
+					// New directories must be watched too, their files may already be there.
+					if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+						this->AddWatch(path);
+
+						std::error_code error;
+						for (auto & entry: std::filesystem::recursive_directory_iterator(path, error)) {
+							if (entry.is_directory(error)) {
+								this->AddWatch(Normalize(entry.path().string()));
+							} else {
+								this->Touch(Normalize(entry.path().string()));
+							}
+						}
+					}
+					continue;
+				}
+
+				// A created file is reported when it is closed.
+				if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE)) {
+					this->Touch(path);
+				}
+			}
+		}
+#endif
+	}
+
+	void FileWatcher::Poll() {
+		auto now = std::chrono::steady_clock::now();
+		if (now - this->_lastPoll < this->pollInterval) {
+			return;
+		}
+		this->_lastPoll = now;
+
+		std::unordered_map<std::string, std::filesystem::file_time_type> snapshot;
+
+		std::error_code error;
+		for (auto & directory: this->_directories) {
+			for (auto & entry: std::filesystem::recursive_directory_iterator(directory, error)) {
+				if (!entry.is_regular_file(error)) {
+					continue;
+				}
+
+				auto path = Normalize(entry.path().string());
+				auto writeTime = entry.last_write_time(error);
+
+				auto previous = this->_snapshot.find(path);
+				if (previous == this->_snapshot.end() || previous->second != writeTime) {
+					this->Touch(path);
+				}
+				snapshot[path] = writeTime;
+			}
+		}
+
+		for (auto & previous: this->_snapshot) {
+			if (!snapshot.contains(previous.first)) {
+				this->Touch(previous.first);
+			}
+		}
+
+		this->_snapshot = std::move(snapshot);
+	}
+
+	void FileWatcher::Update() {
+		this->_changes.clear();
+		this->_changedSet.clear();
+
+		if (this->_directories.empty()) {
+			return;
+		}
+
+		if (this->UseNotify()) {
+			this->ReadNotify();
+		} else {
+			this->Poll();
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		for (auto iterator = this->_pending.begin(); iterator != this->_pending.end();) {
+			if (now - iterator->second >= this->coalesceDelay) {
+				this->_changes.push_back(iterator->first);
+				this->_changedSet.insert(iterator->first);
+				iterator = this->_pending.erase(iterator);
+			} else {
+				iterator++;
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#include <PrettyEngine/intern.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace PrettyEngine {
+	struct InternHash {
+		using is_transparent = void;
+
+		size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+	};
+
+	/// Strings are never removed, the nodes of the set keep their address for the whole program.
+	struct InternPool {
+		std::shared_mutex mutex;
+		std::unordered_set<std::string, InternHash, std::equal_to<>> strings;
+	};
+
+	static const std::string emptyString;
+
+	static InternPool* GetInternPool() {
+		static InternPool pool;
+		return &pool;
+	}
+
+	const std::string* InternedString::Empty() {
+		return &emptyString;
+	}
+
+	const std::string* InternedString::Intern(std::string_view value) {
+		if (value.empty()) {
+			return Empty();
+		}
+
+		auto pool = GetInternPool();
+
+		{
+			std::shared_lock lock(pool->mutex);
+			auto found = pool->strings.find(value);
+			if (found != pool->strings.end()) {
+				return &(*found);
+			}
+		}
+
+		std::unique_lock lock(pool->mutex);
+		return &(*pool->strings.emplace(value).first);
+	}
+
+	bool InternedString::Find(std::string_view value, InternedString* out) {
+		if (value.empty()) {
+			*out = InternedString();
+			return true;
+		}
+
+		auto pool = GetInternPool();
+
+		std::shared_lock lock(pool->mutex);
+		auto found = pool->strings.find(value);
+		if (found != pool->strings.end()) {
+			out->_value = &(*found);
+			return true;
+		}
+		return false;
+	}
+
+	size_t InternedString::GetPoolSize() {
+		auto pool = GetInternPool();
+
+		std::shared_lock lock(pool->mutex);
+		return pool->strings.size();
+	}
+}
@@ -0,0 +1,96 @@
+#include <PrettyEngine/mappedFile.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define PRETTY_MAPPED_FILE_MMAP 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace PrettyEngine {
+	bool MappedFile::Open(const std::string& path) {
+		this->Close();
+
+#if PRETTY_MAPPED_FILE_MMAP
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+
+		struct stat fileStat;
+		// Directories, pipes or devices have no size to map.
+		if (fstat(file, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+			close(file);
+			return false;
+		}
+
+		this->_size = static_cast<size_t>(fileStat.st_size);
+
+		// Empty files can not be mapped but are valid.
+		if (this->_size == 0) {
+			close(file);
+			this->_valid = true;
+			return true;
+		}
+
+		void* data = mmap(nullptr, this->_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+
+		if (data == MAP_FAILED) {
+			this->_size = 0;
+			return this->ReadFallback(path);
+		}
+
+		this->_data = static_cast<const unsigned char*>(data);
+		this->_mapped = true;
+		this->_valid = true;
+		return true;
+#else
+		return this->ReadFallback(path);
+#endif
+	}
+
+	void MappedFile::Close() {
+#if PRETTY_MAPPED_FILE_MMAP
+		if (this->_mapped) {
+			munmap(const_cast<unsigned char*>(this->_data), this->_size);
+		}
+#endif
+		this->_buffer.clear();
+		this->_buffer.shrink_to_fit();
+		this->_data = nullptr;
+		this->_size = 0;
+		this->_valid = false;
+		this->_mapped = false;
+	}
+
+	bool MappedFile::ReadFallback(const std::string& path) {
+		std::error_code error;
+		if (!std::filesystem::is_regular_file(path, error)) {
+			return false;
+		}
+
+		std::ifstream input(path, std::ios::binary | std::ios::ate);
+		if (!input.is_open()) {
+			return false;
+		}
+
+		auto size = static_cast<size_t>(input.tellg());
+		input.seekg(0, std::ios::beg);
+
+		this->_buffer.resize(size);
+		if (size > 0 && !input.read(reinterpret_cast<char*>(this->_buffer.data()), size)) {
+			this->_buffer.clear();
+			return false;
+		}
+
+		this->_data = this->_buffer.data();
+		this->_size = size;
+		this->_valid = true;
+		return true;
+	}
+}
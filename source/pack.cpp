@@ -0,0 +1,231 @@
+#include <PrettyEngine/pack.hpp>
+#include <PrettyEngine/binary.hpp>
+#include <PrettyEngine/debug/debug.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <zlib.h>
+
+namespace PrettyEngine {
+	static std::string_view AsStringView(std::span<const unsigned char> data) {
+		return std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+
+	bool PackFile::Open(const std::string& path) {
+		this->Close();
+
+		if (!this->_file.Open(path)) {
+			return false;
+		}
+
+		auto data = this->_file.GetData();
+		BinaryReader reader(AsStringView(data));
+
+		std::string_view magic;
+		uint32_t version, count, reserved;
+		uint64_t indexOffset, namesOffset;
+		if (!reader.ReadBytes(4, &magic) || magic != PACK_MAGIC ||
+			!reader.ReadU32(&version) || !reader.ReadU32(&count) || !reader.ReadU32(&reserved) ||
+			!reader.ReadU64(&indexOffset) || !reader.ReadU64(&namesOffset)) {
+			DebugLog(LOG_ERROR, "Invalid pack: " << path, false);
+			this->Close();
+			return false;
+		}
+
+		if (version != PACK_VERSION) {
+			DebugLog(LOG_ERROR, "Unsupported pack version " << version << ": " << path, false);
+			this->Close();
+			return false;
+		}
+
+		if (indexOffset > data.size() || namesOffset > data.size() || (data.size() - indexOffset) / PACK_INDEX_ENTRY_SIZE < count) {
+			DebugLog(LOG_ERROR, "Truncated pack: " << path, false);
+			this->Close();
+			return false;
+		}
+
+		auto names = AsStringView(data.subspan(namesOffset));
+
+		BinaryReader index(AsStringView(data.subspan(indexOffset)));
+		this->_entries.resize(count);
+		for (auto & entry: this->_entries) {
+			uint32_t nameOffset, nameSize, compression;
+			index.ReadU64(&entry.hash);
+			index.ReadU64(&entry.offset);
+			index.ReadU64(&entry.size);
+			index.ReadU64(&entry.originalSize);
+			index.ReadU32(&nameOffset);
+			index.ReadU32(&nameSize);
+			index.ReadU32(&compression);
+			index.ReadU32(&reserved);
+
+			if (nameOffset > names.size() || names.size() - nameOffset < nameSize ||
+				entry.offset > data.size() || data.size() - entry.offset < entry.size ||
+				compression > static_cast<uint32_t>(PackCompression::Zlib)) {
+				DebugLog(LOG_ERROR, "Corrupted pack index: " << path, false);
+				this->Close();
+				return false;
+			}
+
+			entry.name = names.substr(nameOffset, nameSize);
+			entry.compression = static_cast<PackCompression>(compression);
+		}
+
+		return true;
+	}
+
+	const PackEntry* PackFile::Find(std::string_view path) const {
+		auto name = NormalizePackPath(path);
+		auto hash = PackHash(name);
+
+		auto found = std::lower_bound(this->_entries.begin(), this->_entries.end(), hash, [](const PackEntry& entry, uint64_t value) {
+			return entry.hash < value;
+		});
+
+		// Different paths can share a hash, the names settle it.
+		for (; found != this->_entries.end() && found->hash == hash; found++) {
+			if (found->name == name) {
+				return &(*found);
+			}
+		}
+		return nullptr;
+	}
+
+	std::span<const unsigned char> PackFile::GetRaw(const PackEntry* entry) const {
+		return this->_file.GetData().subspan(entry->offset, entry->size);
+	}
+
+	bool PackFile::Read(std::string_view path, std::vector<unsigned char>* out) const {
+		auto entry = this->Find(path);
+		if (entry == nullptr) {
+			return false;
+		}
+		return this->Read(entry, out);
+	}
+
+	bool PackFile::Read(const PackEntry* entry, std::vector<unsigned char>* out) const {
+		auto raw = this->GetRaw(entry);
+
+		if (entry->compression == PackCompression::Stored) {
+			out->assign(raw.begin(), raw.end());
+			return true;
+		}
+
+		out->resize(entry->originalSize);
+		uLongf size = static_cast<uLongf>(entry->originalSize);
+		auto result = uncompress(out->data(), &size, raw.data(), static_cast<uLong>(raw.size()));
+		if (result != Z_OK || size != entry->originalSize) {
+			DebugLog(LOG_ERROR, "Failed to decompress: " << entry->name, false);
+			out->clear();
+			return false;
+		}
+		return true;
+	}
+
+	void PackWriter::Add(std::string_view path, std::span<const unsigned char> data, bool compress, float minimumSaving) {
+		Pending pending;
+		pending.name = NormalizePackPath(path);
+		pending.originalSize = data.size();
+		pending.compression = PackCompression::Stored;
+
+		if (compress && !data.empty()) {
+			uLongf size = compressBound(static_cast<uLong>(data.size()));
+			pending.data.resize(size);
+			if (compress2(pending.data.data(), &size, data.data(), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) == Z_OK &&
+				size <= data.size() * (1.0f - minimumSaving)) {
+				pending.data.resize(size);
+				pending.compression = PackCompression::Zlib;
+			}
+		}
+
+		if (pending.compression == PackCompression::Stored) {
+			pending.data.assign(data.begin(), data.end());
+		}
+
+		this->_pending.push_back(std::move(pending));
+	}
+
+	std::vector<unsigned char> PackWriter::Build() const {
+		BinaryWriter writer;
+
+		auto align = [&writer]() {
+			while (writer.buffer.size() % PACK_ALIGNMENT != 0) {
+				writer.WriteU8(0);
+			}
+		};
+
+		writer.WriteBytes(PACK_MAGIC);
+		writer.WriteU32(PACK_VERSION);
+		writer.WriteU32(static_cast<uint32_t>(this->_pending.size()));
+		writer.WriteU32(0);
+		// Offsets are patched once known.
+		writer.WriteU64(0);
+		writer.WriteU64(0);
+
+		std::vector<PackEntry> entries;
+		std::string names;
+		std::vector<uint32_t> nameOffsets;
+
+		for (auto & pending: this->_pending) {
+			align();
+
+			PackEntry entry;
+			entry.hash = PackHash(pending.name);
+			entry.offset = writer.buffer.size();
+			entry.size = pending.data.size();
+			entry.originalSize = pending.originalSize;
+			entry.compression = pending.compression;
+
+			nameOffsets.push_back(static_cast<uint32_t>(names.size()));
+			names += pending.name;
+
+			writer.WriteBytes(AsStringView(pending.data));
+			entries.push_back(entry);
+		}
+
+		std::vector<size_t> order(entries.size());
+		for (size_t i = 0; i < order.size(); i++) {
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [&entries](size_t a, size_t b) {
+			return entries[a].hash < entries[b].hash;
+		});
+
+		align();
+		uint64_t indexOffset = writer.buffer.size();
+		for (auto i: order) {
+			writer.WriteU64(entries[i].hash);
+			writer.WriteU64(entries[i].offset);
+			writer.WriteU64(entries[i].size);
+			writer.WriteU64(entries[i].originalSize);
+			writer.WriteU32(nameOffsets[i]);
+			writer.WriteU32(static_cast<uint32_t>(this->_pending[i].name.size()));
+			writer.WriteU32(static_cast<uint32_t>(entries[i].compression));
+			writer.WriteU32(0);
+		}
+
+		uint64_t namesOffset = writer.buffer.size();
+		writer.WriteBytes(names);
+
+		BinaryWriter offsets;
+		offsets.WriteU64(indexOffset);
+		offsets.WriteU64(namesOffset);
+		std::memcpy(writer.buffer.data() + 16, offsets.buffer.data(), offsets.buffer.size());
+
+		return std::vector<unsigned char>(writer.buffer.begin(), writer.buffer.end());
+	}
+
+	bool PackWriter::Write(const std::string& path) const {
+		auto data = this->Build();
+
+		std::ofstream output(path, std::ios::binary | std::ios::trunc);
+		if (!output.is_open()) {
+			DebugLog(LOG_ERROR, "Failed to write pack: " << path, false);
+			return false;
+		}
+		output.write(reinterpret_cast<const char*>(data.data()), data.size());
+		return output.good();
+	}
+}
@@ -22,6 +22,7 @@
 // GLFW
 #include <GLFW/glfw3.h>
 #include <vector>
+#include <cstddef>
 
 // STB
 #define STB_IMAGE_IMPLEMENTATION
@@ -88,8 +89,6 @@ namespace PrettyEngine {
         mesh.ebo = ebo;
         mesh.drawType = meshDrawType;
 
-        this->glMeshList.insert(std::make_pair(name, mesh));
-
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 8, nullptr);
 
@@ -101,8 +100,35 @@ namespace PrettyEngine {
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 8, (void*)(sizeof(float) * 6));
 
+        // Instance buffer, it starts with a default instance so the non-instanced draws have data to read from the enabled attributes
+        glGenBuffers(1, &mesh.instanceVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.instanceVbo);
+
+        const InstanceData defaultInstance = { glm::mat4(1.0f), glm::vec4(1.0f), 0, {} };
+        glBufferData(GL_ARRAY_BUFFER, sizeof(InstanceData), &defaultInstance, GL_STREAM_DRAW);
+        mesh.instanceCapacity = 1;
+
+        // Model matrix, a column per attribute
+        for (unsigned int column = 0; column < 4; column++) {
+            glEnableVertexAttribArray(3 + column);
+            glVertexAttribPointer(3 + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(offsetof(InstanceData, model) + sizeof(glm::vec4) * column));
+            glVertexAttribDivisor(3 + column, 1);
+        }
+
+        // Base color and opacity
+        glEnableVertexAttribArray(7);
+        glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, color));
+        glVertexAttribDivisor(7, 1);
+
+        // Layer
+        glEnableVertexAttribArray(8);
+        glVertexAttribIPointer(8, 1, GL_INT, sizeof(InstanceData), (void*)offsetof(InstanceData, layer));
+        glVertexAttribDivisor(8, 1);
+
         glBindVertexArray(0);
 
+        this->glMeshList.insert(std::make_pair(name, mesh));
+
         return &this->glMeshList[name];
     }
 
@@ -150,7 +176,12 @@ namespace PrettyEngine {
 			auto shaderProgramRefs = GLShaderProgramRefs();
 			shaderProgramRefs.shaderProgram = shaderProgram;
 
-			shaderProgramRefs.CreateUniformsFromCSV(ASSET_BUILTIN_UNIFORMS);
+			shaderProgramRefs.ResolveUniforms();
+
+			// The samplers always read the same texture units, the program is still bound
+			glUniform1i(shaderProgramRefs.GetUniform(Uniform::TextureBase), RENDER_TEXTURE_UNIT_BASE);
+			glUniform1i(shaderProgramRefs.GetUniform(Uniform::TransparencyTexture), RENDER_TEXTURE_UNIT_TRANSPARENCY);
+			glUniform1i(shaderProgramRefs.GetUniform(Uniform::NormalTexture), RENDER_TEXTURE_UNIT_NORMAL);
 
 			for (auto &renderFeature : this->_renderFeatures) {
 				renderFeature->OnShaderProgram(&shaderProgramRefs);
@@ -165,6 +196,14 @@ namespace PrettyEngine {
     	return &this->glShaderPrograms[name];
     }
 
+    /// Upload every mip level of a cooked texture into the bound texture.
+    static void UploadCookedTextureLevels(const std::vector<CookedTextureLevel>& levels) {
+        for (size_t level = 0; level < levels.size(); level++) {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA16, levels[level].width, levels[level].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[level].pixels.data());
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
+    }
+
     Texture* Renderer::AddTexture(
         std::string name,
         Asset* asset,
@@ -193,19 +232,27 @@ namespace PrettyEngine {
                     std::exit(-1);
                 }
 
-                int width, height;
+                auto file = asset->Map();
 
-                unsigned char *data = stbi_load(asset->GetFilePath().c_str(), &width, &height, nullptr, 0);
-                if (!data) {
-					DebugLog(LOG_ERROR, "Failed to load image: " << asset->GetFilePath(), true);
-                    std::exit(-1);
-                }
+                CookedTexture cooked;
+                if (IsCooked(file.GetData(), COOKED_TEXTURE_MAGIC) && cooked.Load(file.GetData())) {
+                    glBindTexture(GL_TEXTURE_2D, textureID);
+                    UploadCookedTextureLevels(cooked.levels);
+                } else {
+                    int width, height;
+
+                    unsigned char *data = stbi_load_from_memory(file.GetData().data(), static_cast<int>(file.GetSize()), &width, &height, nullptr, 0);
+                    if (!data) {
+                        DebugLog(LOG_ERROR, "Failed to load image: " << asset->GetFilePath(), true);
+                        std::exit(-1);
+                    }
 
-                glBindTexture(GL_TEXTURE_2D, textureID);
+                    glBindTexture(GL_TEXTURE_2D, textureID);
 
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16, width, height, 0, (GLint)channels, GL_UNSIGNED_BYTE, data);
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16, width, height, 0, (GLint)channels, GL_UNSIGNED_BYTE, data);
 
-                stbi_image_free(data);
+                    stbi_image_free(data);
+                }
 
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLenum)wrap);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLenum)wrap);
@@ -239,6 +286,174 @@ namespace PrettyEngine {
         return textureExist.second;
     }
 
+    static int GetTextureChannelsCount(TextureChannels channels) {
+        switch (channels) {
+            case TextureChannels::RGBA:
+                return 4;
+            case TextureChannels::RGB:
+                return 3;
+            default:
+                return 1;
+        }
+    }
+
+    Texture* Renderer::AddTextureAsync(
+        std::string name,
+        AssetHandle asset,
+        TextureType textureType,
+        TextureWrap wrap,
+        TextureFilter filter,
+        TextureChannels channels
+    ) {
+        auto textureExist = this->TextureExist(name);
+        if (textureExist.first) {
+            return textureExist.second;
+        }
+
+        if (!asset.Valid() || !asset->Exist()) {
+            DebugLog(LOG_ERROR, "File not found: " << name, true);
+            return nullptr;
+        }
+
+        asset->SetUsed(true);
+        asset->AddSerializedField(SERIAL_TOKEN(int), "textureChannels", std::to_string(static_cast<int>(channels)));
+        channels = static_cast<TextureChannels>(std::stoi(asset->GetSerializedFieldValue("textureChannels")));
+
+        unsigned int textureID;
+        glGenTextures(1, &textureID);
+        if (!textureID) {
+            DebugLog(LOG_ERROR, "Failed to generate texture for: " << name, true);
+            return nullptr;
+        }
+
+        // Opaque white until the image is ready, so untextured colors stay as they are.
+        const unsigned char placeholder[4] = { 255, 255, 255, 255 };
+
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLenum)wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLenum)wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLenum)filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLenum)filter);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        Texture texture;
+        texture.textureID = textureID;
+        texture.textureType = textureType;
+        texture.wrap = wrap;
+        texture.filter = filter;
+        texture.name = name;
+        texture.ready = false;
+
+        this->glTextures.insert(std::make_pair(name, texture));
+
+        this->StartTextureLoad(name, asset, channels);
+
+        return &this->glTextures[name];
+    }
+
+    void Renderer::StartTextureLoad(const std::string& name, AssetHandle asset, TextureChannels channels) {
+        // Forget the finished loads, their result is in the upload queue.
+        std::erase_if(this->_textureLoads, [](std::future<void>& load) {
+            return load.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+
+        this->_textureLoads.push_back(std::async(std::launch::async, [this, name, asset, channels]() mutable {
+            TextureUpload upload;
+            upload.name = name;
+            upload.channels = channels;
+
+            auto data = asset.GetData();
+
+            // Cooked textures are already decoded, the upload read them straight from the mapped file.
+            CookedTexture cooked;
+            if (IsCooked(data, COOKED_TEXTURE_MAGIC) && cooked.Load(data)) {
+                upload.levels = std::move(cooked.levels);
+                upload.source = asset;
+            } else if (!data.empty()) {
+                int fileChannels;
+                auto pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &upload.width, &upload.height, &fileChannels, GetTextureChannelsCount(channels));
+                if (pixels != nullptr) {
+                    upload.pixels = std::shared_ptr<unsigned char>(pixels, stbi_image_free);
+                }
+            }
+
+            std::lock_guard lock(this->_textureUploadMutex);
+            this->_textureUploads.push_back(std::move(upload));
+        }));
+    }
+
+    bool Renderer::ReloadTexture(const std::string& name, AssetCache* assetCache) {
+        auto texture = this->glTextures.find(name);
+        if (texture == this->glTextures.end()) {
+            return false;
+        }
+
+        assetCache->Invalidate(name);
+        auto asset = assetCache->Acquire(name);
+        if (!asset->Exist()) {
+            return false;
+        }
+
+        auto channels = TextureChannels::RGBA;
+        if (asset->ContainSerializedField("textureChannels")) {
+            channels = static_cast<TextureChannels>(std::stoi(asset->GetSerializedFieldValue("textureChannels")));
+        }
+
+        // The texture keep its id, so the objects using it see the new image once uploaded.
+        texture->second.ready = false;
+        texture->second.failed = false;
+        this->StartTextureLoad(name, asset, channels);
+        return true;
+    }
+
+    void Renderer::ProcessTextureUploads() {
+        for (size_t i = 0; i < this->maxTextureUploadsPerFrame; i++) {
+            TextureUpload upload;
+            {
+                std::lock_guard lock(this->_textureUploadMutex);
+                if (this->_textureUploads.empty()) {
+                    return;
+                }
+                upload = std::move(this->_textureUploads.front());
+                this->_textureUploads.pop_front();
+            }
+
+            // The texture may have been removed while loading.
+            auto texture = this->glTextures.find(upload.name);
+            if (texture == this->glTextures.end()) {
+                continue;
+            }
+
+            if (upload.pixels == nullptr && upload.levels.empty()) {
+                DebugLog(LOG_ERROR, "Failed to load image: " << upload.name, true);
+                // Keep the placeholder, the texture is no longer pending
+                texture->second.failed = true;
+                continue;
+            }
+
+            glBindTexture(GL_TEXTURE_2D, texture->second.textureID);
+            if (!upload.levels.empty()) {
+                UploadCookedTextureLevels(upload.levels);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16, upload.width, upload.height, 0, (GLint)upload.channels, GL_UNSIGNED_BYTE, upload.pixels.get());
+            }
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            texture->second.ready = true;
+        }
+    }
+
+    size_t Renderer::GetPendingTextureCount() {
+        size_t count = 0;
+        for (auto & texture: this->glTextures) {
+            if (!texture.second.ready && !texture.second.failed) {
+                count++;
+            }
+        }
+        return count;
+    }
+
     Texture* Renderer::AddTextureFromData(
         std::string name,
         unsigned char* data,
@@ -303,7 +518,13 @@ namespace PrettyEngine {
     }
 
     Renderer::~Renderer() {
+        // The render features may own GL objects, like the light buffer, they must go while the context exists
+        this->_renderFeatures.clear();
+
         glDeleteFramebuffers(1, &this->frameBuffer);
+        this->spriteBatch.Cleanup();
+        this->_frameUniforms.Destroy();
+        this->_cameraUniforms.Destroy();
 
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
@@ -312,7 +533,6 @@ namespace PrettyEngine {
         glfwDestroyWindow(this->_window);
         glfwTerminate();
 
-    	this->_renderFeatures.clear();
     	this->visualObjects.clear();
         this->Clear(true);
     }
@@ -392,6 +612,11 @@ namespace PrettyEngine {
         ImGui_ImplGlfw_InitForOpenGL(this->_window, true);
 		ImGui_ImplOpenGL3_Init();
 
+        this->spriteBatch.Setup();
+
+        this->_frameUniforms.Create(UNIFORM_BUFFER_FRAME);
+        this->_cameraUniforms.Create(UNIFORM_BUFFER_CAMERA);
+
         syncRenderFeature.get();
 
     	if (GL_CHECK_ERROR()) {
@@ -417,6 +642,32 @@ namespace PrettyEngine {
     	}
     }
 
+    static glm::mat4 GetModelTransform(VisualObject* object) {
+        auto modelTransform = object->GetTransformMatrix();
+        if (object->haveParent) {
+            modelTransform = modelTransform * object->parent->GetTransformMatrix();
+        }
+        return modelTransform;
+    }
+
+    /// Only the programs reading the instance attributes, like the default one, can draw instanced.
+    static bool SupportInstancing(GLShaderProgramRefs* shaderProgram) {
+        return static_cast<GLint>(shaderProgram->GetUniform(Uniform::UseInstancing)) != -1;
+    }
+
+    void Renderer::UploadInstances(Mesh* mesh, const std::vector<InstanceData>& instances) {
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->instanceVbo);
+
+        if (instances.size() > mesh->instanceCapacity) {
+            mesh->instanceCapacity = instances.size();
+            glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(InstanceData), instances.data(), GL_STREAM_DRAW);
+        } else {
+            // Orphan the previous content so the driver does not wait for the draws still reading it
+            glBufferData(GL_ARRAY_BUFFER, mesh->instanceCapacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(InstanceData), instances.data());
+        }
+    }
+
     void Renderer::Draw() {
 #if ENGINE_EDITOR
     	if (GL_CHECK_ERROR()) {
@@ -426,17 +677,25 @@ namespace PrettyEngine {
 
         auto currentTime = static_cast<float>(glfwGetTime());
 
+        this->ProcessTextureUploads();
+
         const bool isMinimized = glfwGetWindowAttrib(this->_window, GLFW_ICONIFIED);
         const bool isFocused = glfwGetWindowAttrib(this->_window, GLFW_FOCUSED);
 
         if (!isMinimized && isFocused) {
-            // Draw all VisualObjects filtered by the layers
-            unsigned int layerCount = 0;
+            this->_renderStats = RenderStats();
+            this->_renderState.SetStats(&this->_renderStats);
 
             for (auto &renderFeature : this->_renderFeatures) {
 				renderFeature->lights = &this->lights;
 				renderFeature->OnInit();
 			}
+
+            FrameUniforms frameUniforms = {};
+            frameUniforms.sunLight = glm::vec4(this->sunColor, this->sunLightFactor);
+            frameUniforms.time = currentTime;
+            frameUniforms.mainLayer = static_cast<int>(this->mainLayer);
+            this->_frameUniforms.Update(frameUniforms);
             
             int width, height;
             glfwGetFramebufferSize(this->_window, &width, &height);
@@ -468,156 +727,202 @@ namespace PrettyEngine {
                         DebugLog(LOG_WARNING, "Got an OpenGL error before rendering !", false);
                     }
 
-                    int layerId = 0;
-                	unsigned int lastShaderProgram = UINT_MAX;
-                    for (auto & layer: this->visualObjects) {
-                        if (!CheckIfVectorContain(&this->hiddenLayers, &layerCount)) {
-                            for(auto & visualObject: layer) {
-                                auto & object = visualObject.second;
-
-                                if (object->d3) {
-                                    this->SwitchTo3D();
-                                } else {
-                                    this->SwitchTo2D();
+                    this->_renderState.Reset();
+
+                    // Collect the visible objects, then draw them sorted by state and depth
+                    this->_renderQueue.Clear();
+                    for (unsigned int layerId = 0; layerId < this->visualObjects.size(); layerId++) {
+                        if (CheckIfVectorContain(&this->hiddenLayers, &layerId)) {
+                            continue;
+                        }
+
+                        for (auto & visualObject: this->visualObjects[layerId]) {
+                            auto object = visualObject.second.get();
+
+                            if (object == nullptr || !object->active) {
+                                continue;
+                            }
+
+                            const auto mesh = object->renderModel->mesh;
+                            const auto shaderProgram = object->renderModel->shaderProgram;
+
+                            if (shaderProgram == nullptr) {
+                                DebugLog(LOG_ERROR, "Missing shader program for: " << visualObject.first, false);
+                                continue;
+                            } else if (mesh == nullptr) {
+                                DebugLog(LOG_ERROR, "Missing mesh for: " << visualObject.first, false);
+                                continue;
+                            }
+
+                            auto baseTexture = object->GetTexture(TextureType::Base);
+                            bool translucent = object->opacity < 1.0f || object->GetTexture(TextureType::Transparency) != nullptr;
+
+                            float depth = 0.0f;
+                            if (!object->screenObject) {
+                                depth = glm::length(object->position - camera.position) / cameraProjection->farPlane;
+                            }
+
+                            auto key = RenderQueue::MakeKey(
+                                layerId,
+                                translucent,
+                                object->d3,
+                                shaderProgram->shaderProgram,
+                                baseTexture != nullptr ? baseTexture->textureID : 0,
+                                mesh->vao,
+                                depth
+                            );
+
+                            this->_renderQueue.Add(key, object, &visualObject.first);
+                        }
+                    }
+                    this->_renderQueue.Sort();
+
+                    cameraProjection->aspectRatio = aspectRatio;
+                    const auto cameraPerspective = glm::perspective(glm::radians(cameraProjection->fov), cameraProjection->aspectRatio, cameraProjection->nearPlane, cameraProjection->farPlane);
+
+                    CameraUniforms cameraUniforms = {};
+                    cameraUniforms.view = currentCameraMatrix;
+                    cameraUniforms.projection = cameraPerspective;
+                    cameraUniforms.colorFilter = glm::vec4(camera.colorFilter, 0.0f);
+                    this->_cameraUniforms.Update(cameraUniforms);
+
+                    // Sprites are drawn after the visual objects of their layer
+                    this->spriteBatch.BeginPass(&this->_renderState, &this->_renderStats, &this->hiddenLayers);
+
+                    // The uniform makers and the render features are called once per draw, an instanced draw is only allowed when none of them needs each object
+                    bool instancing = this->instancing && this->_uniformMakers.empty();
+                    for(auto & renderFeature: this->_renderFeatures) {
+                        instancing = instancing && renderFeature->SupportInstancing();
+                    }
+
+                    auto & items = this->_renderQueue.GetItems();
+                    for (size_t itemIndex = 0; itemIndex < items.size();) {
+                        auto object = items[itemIndex].object;
+
+                        this->spriteBatch.DrawUntilLayer(object->renderLayer);
+
+                        // The next objects sharing the state of this one are drawn with it by a single instanced draw call
+                        size_t instanceCount = 1;
+                        if (instancing && object->render && object->allowInstancing && SupportInstancing(object->renderModel->shaderProgram)) {
+                            while (itemIndex + instanceCount < items.size() && RenderQueue::SameInstanceState(object, items[itemIndex + instanceCount].object)) {
+                                instanceCount++;
+                            }
+                        }
+
+                        this->_renderState.SetDepthTest(object->d3);
+
+                        const auto mesh = object->renderModel->mesh;
+                        const auto shaderProgram = object->renderModel->shaderProgram;
+
+                        // The element buffer is part of the vertex array state
+                        this->_renderState.BindVertexArray(mesh->vao);
+                        this->_renderState.UseProgram(shaderProgram->shaderProgram);
+
+                        for(auto & uniformMaker: this->_uniformMakers) {
+                            uniformMaker(object, &camera);
+                        }
+
+                        Graphics::BindVariable(shaderProgram->GetUniform(Uniform::Model), GetModelTransform(object));
+
+                        if (object->render) {
+                            // The view and projection of the camera come from the CameraData block
+                            const bool overrideCamera = object->screenObject || object->renderModel->overrideProjection;
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::OverrideCamera), overrideCamera);
+
+                            if (overrideCamera) {
+                                auto view = glm::identity<glm::mat4>();
+                                auto projection = glm::identity<glm::mat4>();
+
+                                if (!object->screenObject) {
+                                    view = currentCameraMatrix;
+                                    object->renderModel->projection->aspectRatio = aspectRatio;
+                                    projection = glm::perspective(glm::radians(object->renderModel->projection->fov), object->renderModel->projection->aspectRatio, object->renderModel->projection->nearPlane, object->renderModel->projection->farPlane);
+                                }
+
+                                Graphics::BindVariable(shaderProgram->GetUniform(Uniform::ObjectView), view);
+                                Graphics::BindVariable(shaderProgram->GetUniform(Uniform::ObjectProjection), projection);
+                            }
+
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::BaseColor), object->baseColor);
+
+                            auto baseTexture = object->GetTexture(TextureType::Base);
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::UseTexture), baseTexture != nullptr);
+                            auto transparencyTexture = object->GetTexture(TextureType::Transparency);
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::UseTransparencyTexture), transparencyTexture != nullptr);
+                            auto normalTexture = object->GetTexture(TextureType::Normal);
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::UseNormal), normalTexture != nullptr);
+
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::Layer), object->renderLayer);
+
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::Opacity), object->opacity);
+
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::UseSunLight), object->sunLight);
+
+                            for(auto & renderFeature: this->_renderFeatures) {
+                                renderFeature->OnUniform(object);
+                            }
+
+                            for(auto & renderFeature: this->_renderFeatures) {
+                                renderFeature->OnRender(object);
+                            }
+
+                            if (object->renderModel->useTexture) {
+                                if (baseTexture != nullptr) {
+                                    this->_renderState.BindTexture(RENDER_TEXTURE_UNIT_BASE, baseTexture->textureID);
+                                }
+
+                                if (transparencyTexture != nullptr) {
+                                    this->_renderState.BindTexture(RENDER_TEXTURE_UNIT_TRANSPARENCY, transparencyTexture->textureID);
+                                }
+
+                                if (normalTexture != nullptr) {
+                                    this->_renderState.BindTexture(RENDER_TEXTURE_UNIT_NORMAL, normalTexture->textureID);
                                 }
+                            }
+
+                            this->_renderState.SetPolygonMode(object->wireFrame ? GL_LINE : GL_FILL);
+
+                            Graphics::BindVariable(shaderProgram->GetUniform(Uniform::UseInstancing), instanceCount > 1);
 
-                                if (object != nullptr && object->active) {
-                                    auto projection = glm::identity<glm::mat4>();
-
-                                    if (!object->screenObject) {
-                                        if (object->renderModel->overrideProjection) {
-                                            object->renderModel->projection->aspectRatio = aspectRatio;
-                                            projection = glm::perspective(glm::radians(object->renderModel->projection->fov), object->renderModel->projection->aspectRatio, object->renderModel->projection->nearPlane, object->renderModel->projection->farPlane);
-                                        } else {
-                                            cameraProjection->aspectRatio = aspectRatio;
-                                            projection = glm::perspective(glm::radians(cameraProjection->fov), cameraProjection->aspectRatio, cameraProjection->nearPlane, cameraProjection->farPlane);
-                                        }
-                                    }
-
-                                    const auto mesh = object->renderModel->mesh;
-                                    const auto shaderProgram = object->renderModel->shaderProgram;
-
-                                    if (shaderProgram == nullptr) {
-                                        DebugLog(LOG_ERROR, "Missing shader program for: " << visualObject.first, false);
-                                    } else if (mesh == nullptr) {
-                                        DebugLog(LOG_ERROR, "Missing mesh for: " << visualObject.first, false);
-                                    } else {
-                                        glBindVertexArray(mesh->vao);
-                                        glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-                                        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
-
-                                    	if (shaderProgram->shaderProgram != lastShaderProgram) {
-                                    		glUseProgram(shaderProgram->shaderProgram);
-                                    		lastShaderProgram = shaderProgram->shaderProgram;
-                                    	}
-
-                                        auto modelTransform = object->GetTransformMatrix();
-                                        if (object->haveParent) {
-                                            modelTransform = modelTransform * object->parent->GetTransformMatrix();
-                                        }
-
-                                        for(auto & uniformMaker: this->_uniformMakers) {
-                                            uniformMaker(object.get(), &camera);
-                                        }
-
-                                        Graphics::BindVariable(shaderProgram->uniforms["Model"], modelTransform);
-
-                                        glm::mat4 view = currentCameraMatrix;
-
-                                        if (object->screenObject) {
-                                            view = glm::identity<glm::mat4>();
-                                        }
-
-                                        if (object->render) {
-                                            Graphics::BindVariable(shaderProgram->uniforms["View"], view);
-                                            Graphics::BindVariable(shaderProgram->uniforms["Projection"], projection);
-                                            Graphics::BindVariable(shaderProgram->uniforms["Time"], currentTime);
-                                            Graphics::BindVariable(shaderProgram->uniforms["BaseColor"], object->baseColor);
-                                            Graphics::BindVariable(shaderProgram->uniforms["ColorFilter"], camera.colorFilter);
-
-                                            auto baseTexture = object->GetTexture(TextureType::Base);
-                                            Graphics::BindVariable(shaderProgram->uniforms["UseTexture"], baseTexture != nullptr);
-                                            auto transparencyTexture = object->GetTexture(TextureType::Transparency);
-                                            Graphics::BindVariable(shaderProgram->uniforms["UseTransparencyTexture"], transparencyTexture != nullptr);
-                                            auto normalTexture = object->GetTexture(TextureType::Normal);
-                                            Graphics::BindVariable(shaderProgram->uniforms["UseNormal"], normalTexture != nullptr);
-
-                                            Graphics::BindVariable(shaderProgram->uniforms["Layer"], object->renderLayer);
-                                            Graphics::BindVariable(shaderProgram->uniforms["MainLayer"], this->mainLayer);
-
-                                            Graphics::BindVariable(shaderProgram->uniforms["Opacity"], object->opacity);
-
-                                            Graphics::BindVariable(shaderProgram->uniforms["UseSunLight"], object->sunLight);
-                                            if (object->sunLight) {
-                                                Graphics::BindVariable(shaderProgram->uniforms["SunLightColor"], this->sunColor);
-                                                Graphics::BindVariable(shaderProgram->uniforms["SunLightFactor"], this->sunLightFactor);
-                                            }
-
-                                            for(auto & renderFeature: this->_renderFeatures) {
-                                                renderFeature->OnUniform(object.get());
-                                            }
-
-                                            for(auto & renderFeature: this->_renderFeatures) {
-                                                renderFeature->OnRender(object.get());
-                                            }
-
-                                            if (object->renderModel->useTexture) {
-                                                if (baseTexture != nullptr) {
-                                                    glActiveTexture(GL_TEXTURE0);
-
-                                                    glBindTexture(GL_TEXTURE_2D, baseTexture->textureID);
-
-                                                    glUniform1i(glGetUniformLocation(
-                                                        object->renderModel->shaderProgram->shaderProgram,
-                                                        "textureBase"
-                                                    ), 0);
-                                                }
-
-                                                if (transparencyTexture != nullptr) {
-                                                    glActiveTexture(GL_TEXTURE1);
-
-                                                    glBindTexture(GL_TEXTURE_2D, transparencyTexture->textureID);
-
-                                                    glUniform1i(glGetUniformLocation(
-                                                        object->renderModel->shaderProgram->shaderProgram,
-                                                        "transparencyTexture"
-                                                    ), 0);
-                                                }
-
-                                                if (normalTexture != nullptr) {
-                                                    glActiveTexture(GL_TEXTURE3);
-
-                                                    glBindTexture(GL_TEXTURE_2D, normalTexture->textureID);
-
-                                                    glUniform1i(glGetUniformLocation(
-                                                        object->renderModel->shaderProgram->shaderProgram,
-                                                        "normalTexture"
-                                                    ), 0);
-                                                }
-                                            }
-
-                                            if (object->wireFrame) {
-												glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-                                            } else {
-                                                glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-                                            }
-
-                                            glDrawElements(static_cast<GLenum>(object->renderModel->drawMode), mesh->vertexCount, GL_UNSIGNED_INT, nullptr);
-                                        }
-
-                                        object->OnDraw((void*)this);
-                                        glBindVertexArray(0);
-
-                                        if (GL_CHECK_ERROR()) {
-                                            object->active = false;
-                                            DebugLog(LOG_WARNING, "OpenGL error triggered on: " << visualObject.first, false);
-                                        }
-                                    }
+                            if (instanceCount > 1) {
+                                this->_instances.clear();
+                                for (size_t i = itemIndex; i < itemIndex + instanceCount; i++) {
+                                    auto instanceObject = items[i].object;
+                                    this->_instances.push_back(InstanceData{
+                                        GetModelTransform(instanceObject),
+                                        glm::vec4(instanceObject->baseColor, instanceObject->opacity),
+                                        static_cast<int>(instanceObject->renderLayer),
+                                    });
                                 }
+                                this->UploadInstances(mesh, this->_instances);
+
+                                glDrawElementsInstanced(static_cast<GLenum>(object->renderModel->drawMode), mesh->vertexCount, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(instanceCount));
+                                this->_renderStats.instancedObjects += instanceCount;
+                            } else {
+                                glDrawElements(static_cast<GLenum>(object->renderModel->drawMode), mesh->vertexCount, GL_UNSIGNED_INT, nullptr);
                             }
+                            this->_renderStats.drawCalls++;
                         }
+
+                        for (size_t i = itemIndex; i < itemIndex + instanceCount; i++) {
+                            items[i].object->OnDraw((void*)this);
+                        }
+
+                        if (GL_CHECK_ERROR()) {
+                            for (size_t i = itemIndex; i < itemIndex + instanceCount; i++) {
+                                items[i].object->active = false;
+                                DebugLog(LOG_WARNING, "OpenGL error triggered on: " << *items[i].name, false);
+                            }
+                        }
+
+                        itemIndex += instanceCount;
                     }
-                    
+
+                    this->spriteBatch.EndPass();
+
+                    glBindVertexArray(0);
+                    this->_renderState.Reset();
+
                     renderImGUI.wait();
                     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
@@ -626,6 +931,9 @@ namespace PrettyEngine {
             }
         }
 
+        // Sprites are submitted again every frame
+        this->spriteBatch.Clear();
+
         // End the frame even if the window is not rendered
         ImGui::EndFrame();
     }
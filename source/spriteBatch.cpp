@@ -0,0 +1,264 @@
+#include <PrettyEngine/render/spriteBatch.hpp>
+#include <PrettyEngine/debug/debug.hpp>
+#include <PrettyEngine/shaders.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/// Bits of each field of a sprite key, from the most significant.
+#define SPRITE_KEY_LAYER_BITS 16
+#define SPRITE_KEY_TEXTURE_BITS 24
+#define SPRITE_KEY_INDEX_BITS 23
+
+namespace PrettyEngine {
+	static constexpr uint64_t SpriteKeyMask(int bits) {
+		return (uint64_t(1) << bits) - 1;
+	}
+
+	static unsigned int CompileSpriteShader(GLenum type, const char* source) {
+		unsigned int shader = glCreateShader(type);
+		glShaderSource(shader, 1, &source, nullptr);
+		glCompileShader(shader);
+
+		int status;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+		if (!status) {
+			char buffer[512];
+			glGetShaderInfoLog(shader, 512, nullptr, buffer);
+			DebugLog(LOG_ERROR, "Failed to compile the sprite shader: " << buffer, true);
+		}
+
+		return shader;
+	}
+
+	void SpriteBatch::Setup() {
+		auto vertexShader = CompileSpriteShader(GL_VERTEX_SHADER, Shaders::SHADER_SPRITE_VERTEX);
+		auto fragmentShader = CompileSpriteShader(GL_FRAGMENT_SHADER, Shaders::SHADER_SPRITE_FRAGMENT);
+
+		this->_program = glCreateProgram();
+		glAttachShader(this->_program, vertexShader);
+		glAttachShader(this->_program, fragmentShader);
+		glBindFragDataLocation(this->_program, 0, "outColor");
+		glLinkProgram(this->_program);
+
+		// The program keep the compiled code
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+
+		this->_screenUniform = glGetUniformLocation(this->_program, "screen");
+		this->_useTextureUniform = glGetUniformLocation(this->_program, "useTexture");
+		glProgramUniform1i(this->_program, glGetUniformLocation(this->_program, "textureBase"), RENDER_TEXTURE_UNIT_BASE);
+
+		glGenVertexArrays(1, &this->_vao);
+		glBindVertexArray(this->_vao);
+
+		glGenBuffers(1, &this->_vbo);
+		glBindBuffer(GL_ARRAY_BUFFER, this->_vbo);
+
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, position));
+
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, color));
+
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, textureCoord));
+
+		// Filled by Prepare, the vertex array keep the binding
+		glGenBuffers(1, &this->_ebo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->_ebo);
+
+		glBindVertexArray(0);
+
+		if (GL_CHECK_ERROR()) {
+			DebugLog(LOG_ERROR, "OpenGL error during the sprite batch setup", true);
+		}
+	}
+
+	void SpriteBatch::Cleanup() {
+		glDeleteBuffers(1, &this->_vbo);
+		glDeleteBuffers(1, &this->_ebo);
+		glDeleteVertexArrays(1, &this->_vao);
+		glDeleteProgram(this->_program);
+
+		this->_vbo = 0;
+		this->_ebo = 0;
+		this->_vao = 0;
+		this->_program = 0;
+		this->_indexCapacity = 0;
+		this->_vertexBufferSize = 0;
+	}
+
+	void SpriteBatch::Draw(unsigned int texture, const glm::mat4& model, glm::vec4 color, unsigned int layer, bool screen, glm::vec4 uv) {
+		const glm::vec3 corners[4] = {
+			glm::vec3(model * glm::vec4(-0.5f, 0.5f, 0.0f, 1.0f)),
+			glm::vec3(model * glm::vec4(0.5f, 0.5f, 0.0f, 1.0f)),
+			glm::vec3(model * glm::vec4(0.5f, -0.5f, 0.0f, 1.0f)),
+			glm::vec3(model * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f)),
+		};
+
+		this->AddQuad(texture, layer, screen, corners, color, uv);
+	}
+
+	void SpriteBatch::Draw(unsigned int texture, glm::vec3 position, glm::vec2 size, float rotation, glm::vec4 color, unsigned int layer, bool screen, glm::vec4 uv) {
+		const auto halfSize = size * 0.5f;
+
+		// Half axes of the quad after rotation
+		const float cosine = std::cos(rotation);
+		const float sine = std::sin(rotation);
+		const glm::vec3 right = glm::vec3(cosine, sine, 0.0f) * halfSize.x;
+		const glm::vec3 up = glm::vec3(-sine, cosine, 0.0f) * halfSize.y;
+
+		const glm::vec3 corners[4] = {
+			position - right + up,
+			position + right + up,
+			position + right - up,
+			position - right - up,
+		};
+
+		this->AddQuad(texture, layer, screen, corners, color, uv);
+	}
+
+	void SpriteBatch::AddQuad(unsigned int texture, unsigned int layer, bool screen, const glm::vec3* corners, glm::vec4 color, glm::vec4 uv) {
+		const auto index = this->_keys.size();
+		if (index > SpriteKeyMask(SPRITE_KEY_INDEX_BITS)) {
+			DebugLog(LOG_WARNING, "Too many sprites this frame, the sprite is not drawn", false);
+			return;
+		}
+
+		uint64_t key = std::min<uint64_t>(layer, SpriteKeyMask(SPRITE_KEY_LAYER_BITS));
+		key = (key << 1) | static_cast<uint64_t>(screen);
+		key = (key << SPRITE_KEY_TEXTURE_BITS) | (texture & SpriteKeyMask(SPRITE_KEY_TEXTURE_BITS));
+		key = (key << SPRITE_KEY_INDEX_BITS) | index;
+		this->_keys.push_back(key);
+
+		this->_vertices.push_back(SpriteVertex{corners[0], color, glm::vec2(uv.x, uv.y)});
+		this->_vertices.push_back(SpriteVertex{corners[1], color, glm::vec2(uv.z, uv.y)});
+		this->_vertices.push_back(SpriteVertex{corners[2], color, glm::vec2(uv.z, uv.w)});
+		this->_vertices.push_back(SpriteVertex{corners[3], color, glm::vec2(uv.x, uv.w)});
+
+		this->_prepared = false;
+	}
+
+	void SpriteBatch::Prepare() {
+		this->_prepared = true;
+		this->_runs.clear();
+
+		if (this->_keys.empty()) {
+			return;
+		}
+
+		// The index is the lowest field, so sprites of the same group keep their submission order
+		std::sort(this->_keys.begin(), this->_keys.end());
+
+		this->_sortedVertices.resize(this->_vertices.size());
+		for (size_t i = 0; i < this->_keys.size(); i++) {
+			const auto key = this->_keys[i];
+			const auto index = key & SpriteKeyMask(SPRITE_KEY_INDEX_BITS);
+			std::copy_n(&this->_vertices[index * 4], 4, &this->_sortedVertices[i * 4]);
+
+			const auto group = key >> SPRITE_KEY_INDEX_BITS;
+			if (this->_runs.empty() || (this->_keys[i - 1] >> SPRITE_KEY_INDEX_BITS) != group) {
+				this->_runs.push_back(SpriteRun{
+					static_cast<unsigned int>(group >> (SPRITE_KEY_TEXTURE_BITS + 1)),
+					static_cast<bool>((group >> SPRITE_KEY_TEXTURE_BITS) & 1),
+					static_cast<unsigned int>(group & SpriteKeyMask(SPRITE_KEY_TEXTURE_BITS)),
+					i,
+					0,
+				});
+			}
+			this->_runs.back().count++;
+		}
+
+		const auto quadCount = this->_keys.size();
+
+		this->_state->BindVertexArray(this->_vao);
+
+		// Every quad use the same 6 indices, the index buffer only grow
+		if (quadCount > this->_indexCapacity) {
+			this->_indexCapacity = std::max(quadCount, this->_indexCapacity * 2);
+
+			std::vector<unsigned int> indices;
+			indices.reserve(this->_indexCapacity * 6);
+			for (unsigned int quad = 0; quad < this->_indexCapacity; quad++) {
+				const unsigned int first = quad * 4;
+				for (auto offset: { 0u, 1u, 2u, 2u, 3u, 0u }) {
+					indices.push_back(first + offset);
+				}
+			}
+
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, this->_vbo);
+
+		const auto size = this->_sortedVertices.size() * sizeof(SpriteVertex);
+		if (size > this->_vertexBufferSize) {
+			this->_vertexBufferSize = std::max(size, this->_vertexBufferSize * 2);
+		}
+		// Orphan the buffer of the previous frame so the driver does not wait for the draws still reading it
+		glBufferData(GL_ARRAY_BUFFER, this->_vertexBufferSize, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, this->_sortedVertices.data());
+	}
+
+	void SpriteBatch::BeginPass(RenderStateCache* state, RenderStats* stats, const std::vector<unsigned int>* hiddenLayers) {
+		this->_state = state;
+		this->_stats = stats;
+		this->_hiddenLayers = hiddenLayers;
+		this->_nextRun = 0;
+
+		if (this->_keys.empty()) {
+			return;
+		}
+
+		if (!this->_prepared) {
+			this->Prepare();
+		}
+	}
+
+	void SpriteBatch::DrawUntilLayer(unsigned int layer) {
+		while (this->_nextRun < this->_runs.size() && this->_runs[this->_nextRun].layer < layer) {
+			this->DrawRun(this->_runs[this->_nextRun]);
+			this->_nextRun++;
+		}
+	}
+
+	void SpriteBatch::EndPass() {
+		while (this->_nextRun < this->_runs.size()) {
+			this->DrawRun(this->_runs[this->_nextRun]);
+			this->_nextRun++;
+		}
+	}
+
+	void SpriteBatch::DrawRun(const SpriteRun& run) {
+		if (this->_hiddenLayers != nullptr && std::find(this->_hiddenLayers->begin(), this->_hiddenLayers->end(), run.layer) != this->_hiddenLayers->end()) {
+			return;
+		}
+
+		this->_state->SetDepthTest(false);
+		this->_state->SetPolygonMode(GL_FILL);
+		this->_state->UseProgram(this->_program);
+		this->_state->BindVertexArray(this->_vao);
+
+		// The view and projection of the camera come from the CameraData block
+		glUniform1i(this->_screenUniform, run.screen);
+		glUniform1i(this->_useTextureUniform, run.texture != 0);
+		if (run.texture != 0) {
+			this->_state->BindTexture(RENDER_TEXTURE_UNIT_BASE, run.texture);
+		}
+
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(run.count * 6), GL_UNSIGNED_INT, (void*)(run.first * 6 * sizeof(unsigned int)));
+
+		if (this->_stats != nullptr) {
+			this->_stats->drawCalls++;
+		}
+	}
+
+	void SpriteBatch::Clear() {
+		this->_keys.clear();
+		this->_vertices.clear();
+		this->_runs.clear();
+		this->_prepared = false;
+	}
+}
@@ -0,0 +1,248 @@
+#include <PrettyEngine/vfs.hpp>
+#include <PrettyEngine/assetManager.hpp>
+#include <PrettyEngine/builtinAssets.hpp>
+#include <PrettyEngine/debug/debug.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+
+namespace PrettyEngine {
+	/// Same form for the mount points and the looked up paths, "./public/a" and "public/a" are the same file.
+	static std::string NormalizeVirtualPath(const std::string& path) {
+		auto normalized = std::filesystem::path(path).lexically_normal().generic_string();
+		if (normalized == ".") {
+			return "";
+		}
+		return normalized;
+	}
+
+	VirtualFile PackLayer::Open(const std::string& entryPath) {
+		auto entry = this->pack->Find(entryPath);
+		if (entry == nullptr) {
+			return VirtualFile();
+		}
+
+		// Stored entries are used in place, the layer may be unmounted while they are in use.
+		if (entry->compression == PackCompression::Stored) {
+			return VirtualFile::FromView(this->pack->GetRaw(entry), this->pack);
+		}
+
+		std::vector<unsigned char> data;
+		if (!this->pack->Read(entry, &data)) {
+			return VirtualFile();
+		}
+		return VirtualFile::FromBuffer(std::move(data));
+	}
+
+	static void SplitDataBasePath(const std::string& path, std::string* directory, std::string* name) {
+		auto separator = path.find_last_of('/');
+		if (separator == std::string::npos) {
+			*directory = "";
+			*name = path;
+		} else {
+			*directory = path.substr(0, separator);
+			*name = path.substr(separator + 1);
+		}
+	}
+
+	bool DataBaseLayer::Exists(const std::string& path) {
+		std::string directory, name;
+		SplitDataBasePath(path, &directory, &name);
+		return AssetDataBase::GetBinarySize(directory, name) >= 0;
+	}
+
+	VirtualFile DataBaseLayer::Open(const std::string& path) {
+		std::string directory, name;
+		SplitDataBasePath(path, &directory, &name);
+
+		auto size = AssetDataBase::GetBinarySize(directory, name);
+		if (size < 0) {
+			return VirtualFile();
+		}
+
+		std::vector<unsigned char> data(size);
+		if (!AssetDataBase::ReadBinary(directory, name, 0, data)) {
+			return VirtualFile();
+		}
+		return VirtualFile::FromBuffer(std::move(data));
+	}
+
+	void BuiltinLayer::Add(const std::string& path, std::span<const unsigned char> data) {
+		std::unique_lock lock(this->mutex);
+		this->files[NormalizeVirtualPath(path)] = data;
+	}
+
+	bool BuiltinLayer::Exists(const std::string& path) {
+		{
+			std::shared_lock lock(this->mutex);
+			if (this->files.contains(path)) {
+				return true;
+			}
+		}
+		return BuiltinAssetExists(path);
+	}
+
+	VirtualFile BuiltinLayer::Open(const std::string& path) {
+		std::shared_lock lock(this->mutex);
+
+		auto file = this->files.find(path);
+		if (file != this->files.end()) {
+			return VirtualFile::FromView(file->second);
+		}
+
+		// Embedded assets are only decompressed once opened.
+		if (BuiltinAssetExists(path)) {
+			return VirtualFile::FromView(GetBuiltinAssetData(path));
+		}
+		return VirtualFile();
+	}
+
+	VirtualFileSystem* VirtualFileSystem::Get() {
+		static VirtualFileSystem* instance = []{
+			auto vfs = new VirtualFileSystem();
+			vfs->Mount("", std::make_shared<DirectoryLayer>(), VFS_PRIORITY_LOOSE);
+			vfs->Mount(VFS_BUILTIN_MOUNT, GetBuiltinLayer(), VFS_PRIORITY_BUILTIN);
+			return vfs;
+		}();
+		return instance;
+	}
+
+	std::shared_ptr<BuiltinLayer> VirtualFileSystem::GetBuiltinLayer() {
+		static auto builtins = std::make_shared<BuiltinLayer>();
+		return builtins;
+	}
+
+	void VirtualFileSystem::MountPublic(const std::string& publicPath, const std::string& packPath) {
+		auto pack = std::make_shared<PackLayer>(packPath);
+		if (pack->Valid()) {
+			this->Mount(publicPath, pack, VFS_PRIORITY_PACK);
+			DebugLog(LOG_INFO, "Mounted: " << packPath, false);
+		}
+
+		this->Mount(publicPath, std::make_shared<DataBaseLayer>(), VFS_PRIORITY_DATABASE);
+	}
+
+	void VirtualFileSystem::Mount(const std::string& mountPoint, std::shared_ptr<VirtualFileLayer> layer, int priority) {
+		Mounted mounted;
+		mounted.mountPoint = NormalizeVirtualPath(mountPoint);
+		if (!mounted.mountPoint.empty() && !mounted.mountPoint.ends_with('/')) {
+			mounted.mountPoint.push_back('/');
+		}
+		mounted.layer = layer;
+		mounted.priority = priority;
+
+		std::unique_lock lock(this->mutex);
+
+		// Layers of the same priority are searched in the order they were mounted.
+		auto position = std::find_if(this->layers.begin(), this->layers.end(), [priority](const Mounted& other){
+			return other.priority < priority;
+		});
+		this->layers.insert(position, mounted);
+
+		this->resolved.clear();
+	}
+
+	void VirtualFileSystem::Unmount(VirtualFileLayer* layer) {
+		std::unique_lock lock(this->mutex);
+
+		std::erase_if(this->layers, [layer](const Mounted& mounted){
+			return mounted.layer.get() == layer;
+		});
+
+		this->resolved.clear();
+	}
+
+	bool VirtualFileSystem::ResolveUncached(const std::string& path, Resolution* out) {
+		auto normalized = NormalizeVirtualPath(path);
+
+		std::shared_lock lock(this->mutex);
+
+		for (auto & mounted: this->layers) {
+			if (!normalized.starts_with(mounted.mountPoint)) {
+				continue;
+			}
+
+			auto relativePath = normalized.substr(mounted.mountPoint.size());
+			if (mounted.layer->Exists(relativePath)) {
+				out->layer = mounted.layer;
+				out->relativePath = std::move(relativePath);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool VirtualFileSystem::FindResolution(const std::string& path, Resolution* out) {
+		{
+			std::shared_lock lock(this->mutex);
+
+			auto cached = this->resolved.find(path);
+			if (cached != this->resolved.end()) {
+				*out = cached->second;
+				return true;
+			}
+		}
+
+		// Missing files are not remembered, they may be created later.
+		if (!this->ResolveUncached(path, out)) {
+			return false;
+		}
+
+		std::unique_lock lock(this->mutex);
+		this->resolved[path] = *out;
+		return true;
+	}
+
+	bool VirtualFileSystem::Exists(const std::string& path) {
+		Resolution resolution;
+		return this->FindResolution(path, &resolution);
+	}
+
+	VirtualFile VirtualFileSystem::Open(const std::string& path) {
+		Resolution resolution;
+		if (!this->FindResolution(path, &resolution)) {
+			return VirtualFile();
+		}
+
+		auto file = resolution.layer->Open(resolution.relativePath);
+		if (file.Valid()) {
+			return file;
+		}
+
+		// The file moved since it was resolved, look for it again.
+		{
+			std::unique_lock lock(this->mutex);
+			this->resolved.erase(path);
+		}
+
+		if (!this->FindResolution(path, &resolution)) {
+			return VirtualFile();
+		}
+		return resolution.layer->Open(resolution.relativePath);
+	}
+
+	std::string VirtualFileSystem::ReadToString(const std::string& path) {
+		auto file = this->Open(path);
+		auto data = file.GetData();
+		return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+
+	std::shared_ptr<VirtualFileLayer> VirtualFileSystem::Resolve(const std::string& path) {
+		Resolution resolution;
+		if (!this->FindResolution(path, &resolution)) {
+			return nullptr;
+		}
+		return resolution.layer;
+	}
+
+	void VirtualFileSystem::InvalidateResolution() {
+		std::unique_lock lock(this->mutex);
+		this->resolved.clear();
+	}
+
+	size_t VirtualFileSystem::GetResolvedCount() {
+		std::shared_lock lock(this->mutex);
+		return this->resolved.size();
+	}
+}
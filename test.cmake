@@ -7,3 +7,33 @@ add_executable(global_test "${CMAKE_SOURCE_DIR}/test/tests.cpp")
 target_link_libraries(global_test PRIVATE pretty)
 
 add_test(NAME "Global Test" COMMAND global_test)
+
+add_executable(serial_test "${CMAKE_SOURCE_DIR}/test/serialTests.cpp")
+target_link_libraries(serial_test PRIVATE pretty)
+
+add_test(NAME "Serial Test" COMMAND serial_test)
+
+add_executable(pack_test "${CMAKE_SOURCE_DIR}/test/packTests.cpp")
+target_link_libraries(pack_test PRIVATE pretty)
+
+add_test(NAME "Pack Test" COMMAND pack_test)
+
+add_executable(vfs_test "${CMAKE_SOURCE_DIR}/test/vfsTests.cpp")
+target_link_libraries(vfs_test PRIVATE pretty)
+
+add_test(NAME "VFS Test" COMMAND vfs_test)
+
+add_executable(rollback_test "${CMAKE_SOURCE_DIR}/test/rollbackTests.cpp")
+target_link_libraries(rollback_test PRIVATE custom components renderFeatures)
+
+add_test(NAME "Rollback Test" COMMAND rollback_test)
+
+add_executable(data_test "${CMAKE_SOURCE_DIR}/test/dataTests.cpp")
+target_link_libraries(data_test PRIVATE pretty)
+
+add_test(NAME "Data Test" COMMAND data_test)
+
+add_executable(cooked_test "${CMAKE_SOURCE_DIR}/test/cookedTests.cpp")
+target_link_libraries(cooked_test PRIVATE pretty)
+
+add_test(NAME "Cooked Test" COMMAND cooked_test)
\ No newline at end of file
@@ -0,0 +1,158 @@
+/*
+ * Read cooked textures and meshes written in the layout of tools/cook.
+*/
+
+#include <assert.h>
+
+#include <PrettyEngine/cooked.hpp>
+#include <PrettyEngine/binary.hpp>
+#include <PrettyEngine/render/mesh.hpp>
+
+#include <span>
+#include <string>
+#include <vector>
+
+static void Align(PrettyEngine::BinaryWriter* writer) {
+	while (writer->Size() % COOKED_ALIGNMENT != 0) {
+		writer->WriteU8(0);
+	}
+}
+
+static void WriteHeader(PrettyEngine::BinaryWriter* writer, const char* magic) {
+	writer->WriteBytes(magic);
+	writer->WriteU32(COOKED_VERSION);
+}
+
+static std::span<const unsigned char> AsBytes(const std::string& data) {
+	return std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+}
+
+/// 2x2 texture and its 1x1 mip level.
+static std::string CookTexture(uint32_t channels) {
+	const std::vector<std::string> levels = { std::string(2 * 2 * channels, '\x7f'), std::string(channels, '\x10') };
+
+	PrettyEngine::BinaryWriter writer;
+	WriteHeader(&writer, COOKED_TEXTURE_MAGIC);
+	writer.WriteU32(2);
+	writer.WriteU32(2);
+	writer.WriteU32(channels);
+	writer.WriteU32(static_cast<uint32_t>(levels.size()));
+
+	// The level table is followed by the aligned pixels
+	uint64_t offset = writer.Size() + levels.size() * 24;
+	for (size_t i = 0; i < levels.size(); i++) {
+		offset = (offset + COOKED_ALIGNMENT - 1) / COOKED_ALIGNMENT * COOKED_ALIGNMENT;
+		writer.WriteU64(offset);
+		writer.WriteU64(levels[i].size());
+		writer.WriteU32(i == 0 ? 2 : 1);
+		writer.WriteU32(i == 0 ? 2 : 1);
+		offset += levels[i].size();
+	}
+
+	for (auto & level: levels) {
+		Align(&writer);
+		writer.WriteBytes(level);
+	}
+
+	return writer.buffer;
+}
+
+static std::string CookMesh(const std::vector<PrettyEngine::Vertex>& vertices, const std::vector<unsigned int>& indices) {
+	PrettyEngine::BinaryWriter writer;
+	WriteHeader(&writer, COOKED_MESH_MAGIC);
+	writer.WriteU32(static_cast<uint32_t>(vertices.size()));
+	writer.WriteU32(static_cast<uint32_t>(indices.size()));
+
+	const uint64_t vertexOffset = 32;
+	const uint64_t indexOffset = (vertexOffset + vertices.size() * 9 * sizeof(float) + COOKED_ALIGNMENT - 1) / COOKED_ALIGNMENT * COOKED_ALIGNMENT;
+	writer.WriteU64(vertexOffset);
+	writer.WriteU64(indexOffset);
+
+	Align(&writer);
+	assert(writer.Size() == vertexOffset);
+	for (auto & vertex: vertices) {
+		for (auto value: { vertex.position.x, vertex.position.y, vertex.position.z, vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a, vertex.textureCoord.x, vertex.textureCoord.y }) {
+			writer.WriteF32(value);
+		}
+	}
+
+	Align(&writer);
+	assert(writer.Size() == indexOffset);
+	for (auto index: indices) {
+		writer.WriteU32(index);
+	}
+
+	return writer.buffer;
+}
+
+static void TestTexture() {
+	auto data = CookTexture(4);
+
+	PrettyEngine::CookedTexture texture;
+	bool loaded = texture.Load(AsBytes(data));
+	assert(loaded);
+	assert(texture.GetWidth() == 2 && texture.GetHeight() == 2 && texture.GetChannels() == 4);
+	assert(texture.levels.size() == 2);
+	assert(texture.levels[1].width == 1 && texture.levels[1].height == 1);
+	assert(texture.levels[0].pixels.size() == 16 && texture.levels[0].pixels[0] == 0x7f);
+	assert(texture.levels[1].pixels.size() == 4 && texture.levels[1].pixels[0] == 0x10);
+
+	// The pixels are read in place.
+	assert(texture.levels[0].pixels.data() >= AsBytes(data).data() && texture.levels[1].pixels.data() < AsBytes(data).data() + data.size());
+
+	// Only RGBA can be uploaded.
+	auto rgb = CookTexture(3);
+	loaded = texture.Load(AsBytes(rgb));
+	assert(!loaded && texture.levels.empty());
+
+	auto badMagic = data;
+	badMagic[0] = 'X';
+	loaded = texture.Load(AsBytes(badMagic));
+	assert(!loaded);
+
+	for (size_t size = 0; size < data.size(); size++) {
+		loaded = texture.Load(AsBytes(data).subspan(0, size));
+		assert(!loaded);
+	}
+}
+
+static void TestMesh() {
+	std::vector<PrettyEngine::Vertex> vertices(3);
+	for (size_t i = 0; i < vertices.size(); i++) {
+		vertices[i].position = glm::vec3(i, i * 2.0f, -1.0f);
+		vertices[i].color = glm::vec4(0.25f, 0.5f, 0.75f, 1.0f);
+		vertices[i].textureCoord = glm::vec2(i * 0.5f, 1.0f);
+	}
+	const std::vector<unsigned int> indices = { 0, 1, 2 };
+
+	auto data = CookMesh(vertices, indices);
+
+	PrettyEngine::Mesh mesh;
+	bool loaded = PrettyEngine::LoadCookedMesh(AsBytes(data), &mesh);
+	assert(loaded);
+	assert(mesh.vertexCount == 3);
+	assert(mesh.indices == indices);
+	for (size_t i = 0; i < vertices.size(); i++) {
+		assert(mesh.vertices[i].position == vertices[i].position);
+		assert(mesh.vertices[i].color == vertices[i].color);
+		assert(mesh.vertices[i].textureCoord == vertices[i].textureCoord);
+	}
+
+	auto badMagic = data;
+	badMagic[3] = 'X';
+	PrettyEngine::Mesh rejected;
+	loaded = PrettyEngine::LoadCookedMesh(AsBytes(badMagic), &rejected);
+	assert(!loaded);
+
+	for (size_t size = 0; size < data.size(); size++) {
+		loaded = PrettyEngine::LoadCookedMesh(AsBytes(data).subspan(0, size), &rejected);
+		assert(!loaded);
+	}
+}
+
+int main() {
+	TestTexture();
+	TestMesh();
+
+	return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ * Transactions, statement cache, connection pool, upserts and migration of the asset database.
+*/
+
+#include <assert.h>
+
+#include <PrettyEngine/assetManager.hpp>
+#include <PrettyEngine/data.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int CountRows(const std::string& fileName, const std::string& path, const std::string& name) {
+	PrettyEngine::DataBase dataBase(fileName, true);
+	auto count = dataBase.QuerySQLInt("SELECT COUNT(*) FROM \"any\" WHERE path = '" + path + "' AND name = '" + name + "'");
+	return count.empty() ? -1 : count.front();
+}
+
+static void TestTransactions() {
+	PrettyEngine::DataBase dataBase(":memory:");
+	dataBase.ExecuteSQL("CREATE TABLE value (number INTEGER)");
+
+	auto count = [&dataBase]() {
+		return dataBase.QuerySQLInt("SELECT COUNT(*) FROM value").front();
+	};
+
+	{
+		PrettyEngine::SQLTransaction transaction(&dataBase);
+		dataBase.ExecuteSQL("INSERT INTO value VALUES (1)");
+		transaction.Commit();
+	}
+	assert(count() == 1);
+
+	// Not committed, rolled back when destroyed.
+	{
+		PrettyEngine::SQLTransaction transaction(&dataBase);
+		dataBase.ExecuteSQL("INSERT INTO value VALUES (2)");
+	}
+	assert(count() == 1);
+	assert(!dataBase.InTransaction());
+
+	// A nested rollback cancel the outermost transaction too.
+	{
+		PrettyEngine::SQLTransaction outer(&dataBase);
+		dataBase.ExecuteSQL("INSERT INTO value VALUES (3)");
+		{
+			PrettyEngine::SQLTransaction inner(&dataBase);
+			dataBase.ExecuteSQL("INSERT INTO value VALUES (4)");
+		}
+		assert(dataBase.InTransaction());
+		outer.Commit();
+	}
+	assert(count() == 1);
+	assert(!dataBase.InTransaction());
+}
+
+static void TestStatementCache() {
+	PrettyEngine::DataBase dataBase(":memory:");
+	dataBase.ExecuteSQL("CREATE TABLE value (number INTEGER)");
+
+	const std::string insertSQL = "INSERT INTO value VALUES (?1)";
+	const std::string countSQL = "SELECT COUNT(*) FROM value";
+	const std::string sumSQL = "SELECT SUM(number) FROM value";
+
+	// The same SQL give back the same statement, reset and ready to be bound again.
+	auto insert = dataBase.GetStatement(insertSQL);
+	insert->Bind(1, int64_t(1));
+	insert->Step();
+
+	auto reused = dataBase.GetStatement(insertSQL);
+	assert(reused == insert);
+	reused->Bind(1, int64_t(2));
+	reused->Step();
+	reused->Reset();
+	assert(dataBase.GetStatementCacheCount() == 1);
+
+	// Ad-hoc queries are not cached.
+	auto rows = dataBase.QuerySQLInt(countSQL);
+	assert(rows == std::vector<int>{ 2 });
+	assert(dataBase.GetStatementCacheCount() == 1);
+
+	// The least recently used statement is evicted first.
+	dataBase.SetStatementCacheSize(2);
+	auto count = dataBase.GetStatement(countSQL);
+	reused = dataBase.GetStatement(insertSQL);
+	auto sum = dataBase.GetStatement(sumSQL);
+	assert(dataBase.GetStatementCacheCount() == 2);
+
+	reused = dataBase.GetStatement(insertSQL);
+	assert(reused == insert);
+	auto recount = dataBase.GetStatement(countSQL);
+	assert(recount != count);
+
+	// An evicted statement stay usable by its holder.
+	bool found = count->Step();
+	assert(found && count->ColumnInt(0) == 2);
+	count->Reset();
+}
+
+static void TestDataBasePool() {
+	const std::string fileName = "./pool_test.db";
+	const int threadCount = 4;
+	const int writes = 50;
+
+	for (auto suffix: { "", "-wal", "-shm" }) {
+		std::remove((fileName + suffix).c_str());
+	}
+
+	{
+		PrettyEngine::DataBasePool pool(fileName, [](PrettyEngine::DataBase* dataBase) {
+			dataBase->SetJournalMode(PrettyEngine::JournalMode::WAL);
+			dataBase->ExecuteSQL("CREATE TABLE value (number INTEGER)");
+		});
+
+		auto count = [&pool]() {
+			return pool.GetReader()->QuerySQLInt("SELECT COUNT(*) FROM value").front();
+		};
+
+		// Each thread read through its own connection while the others write.
+		std::vector<std::thread> threads;
+		std::vector<PrettyEngine::DataBase*> threadReaders(threadCount);
+		// Every reader stays open until all the threads got theirs, so their addresses can not be reused.
+		std::latch readersOpened(threadCount);
+		for (int thread = 0; thread < threadCount; thread++) {
+			threads.emplace_back([&pool, &threadReaders, &readersOpened, thread]() {
+				for (int i = 0; i < writes; i++) {
+					pool.Write([i](PrettyEngine::DataBase* writer) {
+						auto statement = writer->GetStatement("INSERT INTO value VALUES (?1)");
+						statement->Bind(1, int64_t(i));
+						statement->Step();
+						statement->Reset();
+					});
+					pool.GetReader()->QuerySQLInt("SELECT COUNT(*) FROM value");
+				}
+				threadReaders[thread] = pool.GetReader();
+				readersOpened.arrive_and_wait();
+			});
+		}
+		for (auto & thread: threads) {
+			thread.join();
+		}
+
+		// The connections of the threads are closed when they end.
+		assert(pool.GetReaderCount() == 0);
+
+		assert(count() == threadCount * writes);
+		for (int thread = 1; thread < threadCount; thread++) {
+			assert(threadReaders[thread] != threadReaders[0]);
+		}
+		auto reader = pool.GetReader();
+		auto sameReader = pool.GetReader();
+		assert(sameReader == reader);
+
+		// A write that throws must not keep the writer locked.
+		try {
+			pool.Write([](PrettyEngine::DataBase*) { throw std::runtime_error("write failed"); });
+		} catch (const std::runtime_error&) {}
+
+		bool written = false;
+		std::thread([&pool, &written]() {
+			written = pool.Write([](PrettyEngine::DataBase* writer) { writer->ExecuteSQL("INSERT INTO value VALUES (0)"); });
+		}).join();
+		assert(written);
+
+		// The thread owning the transaction read its pending writes, the others do not see them.
+		bool begun = pool.BeginTransaction();
+		assert(begun);
+		pool.Write([](PrettyEngine::DataBase* writer) { writer->ExecuteSQL("INSERT INTO value VALUES (0)"); });
+
+		int pending = count();
+		int otherThread = 0;
+		std::thread([&count, &otherThread, &pool]() {
+			otherThread = count();
+			pool.ReleaseReader();
+		}).join();
+		assert(pending == threadCount * writes + 2);
+		assert(otherThread == threadCount * writes + 1);
+
+		pool.CommitTransaction();
+		assert(count() == threadCount * writes + 2);
+	}
+
+	{
+		PrettyEngine::DataBasePool readOnly(fileName);
+		readOnly.SetReadOnly(true);
+
+		bool written = readOnly.Write([](PrettyEngine::DataBase*) {});
+		assert(!written);
+		auto values = readOnly.GetReader()->QuerySQLInt("SELECT COUNT(*) FROM value");
+		assert(values == std::vector<int>{ threadCount * writes + 2 });
+	}
+
+	for (auto suffix: { "", "-wal", "-shm" }) {
+		std::remove((fileName + suffix).c_str());
+	}
+}
+
+static void TestAssetDataBase() {
+	// Path of the asset database outside of the editor.
+	const std::string fileName = "./public/assets.db";
+
+	std::filesystem::create_directories("./public");
+	for (auto suffix: { "", "-wal", "-shm" }) {
+		std::remove((fileName + suffix).c_str());
+	}
+
+	// Database written before the unique index, with an outdated duplicate.
+	{
+		PrettyEngine::DataBase legacy(fileName);
+		legacy.ExecuteSQL("CREATE TABLE \"any\" (name TEXT, path TEXT, text TEXT, bin BLOB)");
+		legacy.ExecuteSQL("INSERT INTO \"any\" VALUES ('a', 'textures', 'old', '')");
+		legacy.ExecuteSQL("INSERT INTO \"any\" VALUES ('a', 'textures', 'new', '')");
+	}
+
+	// The last written row is kept by the migration, run by the first access.
+	auto text = PrettyEngine::AssetDataBase::GetText("textures", "a");
+	assert(text == std::vector<std::string>{ "new" });
+	assert(CountRows(fileName, "textures", "a") == 1);
+
+	// Writing an existing asset update its row in place.
+	PrettyEngine::AssetDataBase::SetText("textures", "a", "updated");
+	text = PrettyEngine::AssetDataBase::GetText("textures", "a");
+	assert(text == std::vector<std::string>{ "updated" });
+	assert(CountRows(fileName, "textures", "a") == 1);
+
+	// The text and the binary of an asset are updated separately.
+	const std::vector<unsigned char> binary = { 1, 2, 3, 4 };
+	PrettyEngine::AssetDataBase::SetBinary("textures", "a", binary);
+	text = PrettyEngine::AssetDataBase::GetText("textures", "a");
+	assert(text == std::vector<std::string>{ "updated" });
+	auto size = PrettyEngine::AssetDataBase::GetBinarySize("textures", "a");
+	assert(size == 4);
+	assert(CountRows(fileName, "textures", "a") == 1);
+
+	std::vector<unsigned char> part(2);
+	bool read = PrettyEngine::AssetDataBase::ReadBinary("textures", "a", 2, part);
+	assert(read && part == std::vector<unsigned char>({ 3, 4 }));
+
+	// Batched writes are visible to the other connections only once the outermost batch ends.
+	PrettyEngine::AssetDataBase::BeginBatch();
+	PrettyEngine::AssetDataBase::SetText("textures", "b", "b");
+	PrettyEngine::AssetDataBase::BeginBatch();
+	PrettyEngine::AssetDataBase::SetText("textures", "c", "c");
+	PrettyEngine::AssetDataBase::EndBatch();
+
+	text = PrettyEngine::AssetDataBase::GetText("textures", "c");
+	assert(text == std::vector<std::string>{ "c" });
+	assert(CountRows(fileName, "textures", "b") == 0);
+
+	PrettyEngine::AssetDataBase::EndBatch();
+	assert(CountRows(fileName, "textures", "b") == 1);
+	assert(CountRows(fileName, "textures", "c") == 1);
+}
+
+int main() {
+	TestTransactions();
+	TestStatementCache();
+	TestDataBasePool();
+	TestAssetDataBase();
+
+	return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Write a pack then read every entry back.
+*/
+
+#include <assert.h>
+
+#include <PrettyEngine/pack.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static std::vector<unsigned char> ToBytes(const std::string& text) {
+	return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+int main() {
+	std::string repeated;
+	for (int i = 0; i < 1000; i++) {
+		repeated += "pretty engine ";
+	}
+
+	std::vector<unsigned char> noise(4096);
+	unsigned int seed = 42;
+	for (auto & byte: noise) {
+		seed = seed * 1103515245 + 12345;
+		byte = static_cast<unsigned char>(seed >> 16);
+	}
+
+	PrettyEngine::PackWriter writer;
+	writer.Add("textures/repeated.txt", ToBytes(repeated));
+	writer.Add("./textures\\noise.bin", noise);
+	writer.Add("empty", std::vector<unsigned char>());
+	writer.Add("textures/repeated.txt.meta", ToBytes("exist = true"), false);
+
+	const std::string path = "./pack_test.pak";
+	bool written = writer.Write(path);
+	assert(written);
+
+	{
+		PrettyEngine::PackFile pack(path);
+		assert(pack.Valid());
+		assert(pack.GetEntries().size() == 4);
+
+		// Entries are sorted for the binary search and aligned for direct access.
+		for (size_t i = 0; i < pack.GetEntries().size(); i++) {
+			assert(pack.GetEntries()[i].offset % PACK_ALIGNMENT == 0);
+			if (i > 0) {
+				assert(pack.GetEntries()[i - 1].hash <= pack.GetEntries()[i].hash);
+			}
+		}
+
+		std::vector<unsigned char> out;
+
+		auto repeatedEntry = pack.Find("textures/repeated.txt");
+		assert(repeatedEntry != nullptr);
+		assert(repeatedEntry->compression == PrettyEngine::PackCompression::Zlib);
+		assert(repeatedEntry->size < repeated.size());
+		bool read = pack.Read(repeatedEntry, &out);
+		assert(read && out == ToBytes(repeated));
+
+		// Random data do not compress and must be stored as is.
+		auto noiseEntry = pack.Find("/textures/noise.bin");
+		assert(noiseEntry != nullptr);
+		assert(noiseEntry->compression == PrettyEngine::PackCompression::Stored);
+		read = pack.Read("textures/noise.bin", &out);
+		assert(read && out == noise);
+
+		read = pack.Read("empty", &out);
+		assert(read && out.empty());
+
+		read = pack.Read("textures/repeated.txt.meta", &out);
+		assert(read && out == ToBytes("exist = true"));
+
+		assert(!pack.Contains("textures/missing.txt"));
+		read = pack.Read("textures", &out);
+		assert(!read);
+	}
+
+	// A truncated pack must be rejected.
+	auto data = writer.Build();
+	for (size_t size: { size_t(0), size_t(8), size_t(PACK_HEADER_SIZE), data.size() - 1 }) {
+		FILE* file = fopen(path.c_str(), "wb");
+		fwrite(data.data(), 1, size, file);
+		fclose(file);
+
+		PrettyEngine::PackFile truncated(path);
+		assert(!truncated.Valid());
+	}
+
+	std::remove(path.c_str());
+
+	return 0;
+}
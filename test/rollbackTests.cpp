@@ -0,0 +1,121 @@
+/*
+ * Capture and restore worlds with the rollback buffer.
+*/
+
+#include <assert.h>
+
+#include <PrettyEngine/rollback.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+static PrettyEngine::ColliderState GetColliderState(PrettyEngine::Collider* collider) {
+	return PrettyEngine::ColliderState{PrettyEngine::TransformState::FromTransform(collider), collider->velocity};
+}
+
+int main() {
+	auto worldPath = (std::filesystem::temp_directory_path() / "pretty_rollback_world.toml").string();
+	std::ofstream(worldPath).close();
+
+	auto world = std::make_shared<PrettyEngine::World>(worldPath);
+	std::vector<std::shared_ptr<PrettyEngine::World>> worlds = { world };
+
+	auto entity = CreateCustomEntity("Empty");
+	entity->AddSerializedField("int", "health", "10");
+	world->RegisterEntity(entity);
+
+	PrettyEngine::PhysicalSpace physicalSpace;
+	PrettyEngine::Collider collider;
+	physicalSpace.AddCollider("Default", &collider);
+
+	auto mutate = [&](size_t frame) {
+		entity->position = glm::vec3(static_cast<float>(frame), 2.0f, 0.0f);
+		entity->GetSerializedField("health")->value = std::to_string(100 - frame);
+		collider.velocity = glm::vec3(0.0f, static_cast<float>(frame), 0.0f);
+	};
+
+	// Capture, mutate then restore must give back the captured state.
+	{
+		PrettyEngine::RollbackBuffer buffer(8, 4);
+
+		mutate(1);
+		auto transform = PrettyEngine::TransformState::FromTransform(entity.get());
+		auto health = entity->GetSerializedFieldValue("health");
+		auto colliderState = GetColliderState(&collider);
+		buffer.Capture(1, &worlds, &physicalSpace);
+
+		mutate(42);
+		assert(!(PrettyEngine::TransformState::FromTransform(entity.get()) == transform));
+
+		bool restored = buffer.Restore(1, &physicalSpace);
+		assert(restored);
+		assert(PrettyEngine::TransformState::FromTransform(entity.get()) == transform);
+		assert(entity->GetSerializedFieldValue("health") == health);
+		assert(GetColliderState(&collider) == colliderState);
+	}
+
+	// A delta applied on its keyframe must restore the same state as a full snapshot of that frame.
+	{
+		PrettyEngine::RollbackBuffer deltas(8, 4);
+		PrettyEngine::RollbackBuffer keyframes(8, 1);
+
+		for (size_t frame = 1; frame <= 3; frame++) {
+			mutate(frame);
+			deltas.Capture(frame, &worlds, &physicalSpace);
+			keyframes.Capture(frame, &worlds, &physicalSpace);
+		}
+
+		auto delta = deltas.Restore(3, &physicalSpace);
+		assert(delta);
+		auto deltaTransform = PrettyEngine::TransformState::FromTransform(entity.get());
+		auto deltaHealth = entity->GetSerializedFieldValue("health");
+		auto deltaCollider = GetColliderState(&collider);
+
+		mutate(42);
+
+		auto full = keyframes.Restore(3, &physicalSpace);
+		assert(full);
+		assert(PrettyEngine::TransformState::FromTransform(entity.get()) == deltaTransform);
+		assert(entity->GetSerializedFieldValue("health") == deltaHealth);
+		assert(GetColliderState(&collider) == deltaCollider);
+		assert(deltaHealth == "97");
+	}
+
+	// DropAfter keep the given frame and remove every later one.
+	{
+		PrettyEngine::RollbackBuffer buffer(8, 4);
+
+		for (size_t frame = 1; frame <= 6; frame++) {
+			mutate(frame);
+			buffer.Capture(frame, &worlds, &physicalSpace);
+		}
+
+		buffer.DropAfter(6);
+		assert(buffer.Contains(6));
+		assert(buffer.GetLatestFrame() == 6);
+
+		buffer.DropAfter(3);
+		assert(buffer.Contains(1));
+		assert(buffer.Contains(3));
+		assert(!buffer.Contains(4));
+		assert(!buffer.Contains(6));
+		assert(buffer.GetLatestFrame() == 3);
+		assert(buffer.GetOldestFrame() == 1);
+
+		// Frame 4 is captured again as a delta of the keyframe of frame 1
+		mutate(4);
+		buffer.Capture(4, &worlds, &physicalSpace);
+		mutate(42);
+
+		auto restored = buffer.Restore(4, &physicalSpace);
+		assert(restored);
+		assert(entity->GetSerializedFieldValue("health") == "96");
+		assert(entity->position.x == 4.0f);
+
+		buffer.DropAfter(0);
+		assert(!buffer.Contains(1));
+		assert(buffer.GetLatestFrame() == 0);
+	}
+
+	return 0;
+}
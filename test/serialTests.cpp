@@ -0,0 +1,137 @@
+/*
+ * Round-trip the serialization formats against each other.
+*/
+
+#include <assert.h>
+
+#include <PrettyEngine/serial.hpp>
+#include <PrettyEngine/transform.hpp>
+#include <PrettyEngine/schema.hpp>
+
+static PrettyEngine::SerialObject CreateSample() {
+	PrettyEngine::SerialObject sample;
+	sample.SetObjectSerializedName("Sample");
+	sample.AddSerializedField("float", "speed", "2.5");
+	sample.AddSerializedField("std::string", "name", "player one");
+	sample.AddSerializedField("std::string", "empty", "");
+	sample.AddSerializedField("std::string", "same", "player one");
+	return sample;
+}
+
+static void AssertSameFields(PrettyEngine::SerialObject* a, PrettyEngine::SerialObject* b) {
+	assert(a->serialObjectName == b->serialObjectName);
+	assert(a->serialObjectUnique == b->serialObjectUnique);
+	assert(a->serialFields.size() == b->serialFields.size());
+	for (auto & field: a->serialFields) {
+		assert(b->ContainSerializedField(field.name));
+		assert(b->GetSerilizedFiledType(field.name) == field.type);
+		assert(b->GetSerializedFieldValue(field.name) == field.value);
+	}
+}
+
+int main() {
+	auto sample = CreateSample();
+
+	auto toml = sample.Serialize(PrettyEngine::SerializationFormat::Toml);
+	auto binary = sample.Serialize(PrettyEngine::SerializationFormat::Binary);
+
+	assert(PrettyEngine::DetectSerializationFormat(toml) == PrettyEngine::SerializationFormat::Toml);
+	assert(PrettyEngine::DetectSerializationFormat(binary) == PrettyEngine::SerializationFormat::Binary);
+	assert(binary.size() < toml.size() && "Binary should be more compact");
+
+	PrettyEngine::SerialObject fromToml;
+	fromToml.Deserialize(toml, PrettyEngine::SerializationFormat::Toml);
+
+	PrettyEngine::SerialObject fromBinary;
+	fromBinary.Deserialize(binary, PrettyEngine::SerializationFormat::Binary);
+
+	AssertSameFields(&sample, &fromToml);
+	AssertSameFields(&sample, &fromBinary);
+	AssertSameFields(&fromToml, &fromBinary);
+
+	// Converting from one format to the other must not lose anything, toml sort the fields so only the text is compared as is.
+	assert(fromBinary.Serialize(PrettyEngine::SerializationFormat::Toml) == toml);
+
+	PrettyEngine::SerialObject fromTomlToBinary;
+	fromTomlToBinary.Deserialize(fromToml.Serialize(PrettyEngine::SerializationFormat::Binary), PrettyEngine::SerializationFormat::Binary);
+	AssertSameFields(&sample, &fromTomlToBinary);
+
+	// Truncated data must be rejected without crashing.
+	for (size_t size = 0; size < binary.size(); size++) {
+		PrettyEngine::SerialObject truncated;
+		PrettyEngine::BinaryReader reader(std::string_view(binary).substr(0, size));
+		bool read = truncated.DeserializeFrom(&reader);
+		assert(!read);
+	}
+
+	PrettyEngine::Transform transform;
+	transform.position = glm::vec3(1.0f, -2.0f, 3.5f);
+	transform.Rotate(45.0f);
+	transform.SetScale(glm::vec3(2.0f, 4.0f, 1.0f));
+
+	auto transformTable = toml::table();
+	transform.AddToToml(&transformTable);
+
+	PrettyEngine::Transform transformFromToml;
+	transformFromToml.FromToml(&transformTable);
+
+	PrettyEngine::BinaryWriter writer;
+	transform.AddToBinary(&writer);
+
+	PrettyEngine::Transform transformFromBinary;
+	PrettyEngine::BinaryReader reader(writer.buffer);
+	bool transformRead = transformFromBinary.FromBinary(&reader);
+	assert(transformRead);
+
+	assert(transformFromBinary.position == transformFromToml.position);
+	assert(transformFromBinary.rotation == transformFromToml.rotation);
+	assert(transformFromBinary.scale == transformFromToml.scale);
+	assert(transformFromBinary.halfScale == transform.halfScale);
+
+	// Objects saved without schema are migrated once, then kept as they are.
+	auto schema = PrettyEngine::SerialSchema(2)
+		.Field("float", "speed", "1")
+		.Field("int", "lives", "3")
+		.Migration(0, [](PrettyEngine::SerialObject* object) { object->RenameSerializedField("name", "displayName"); })
+		.Migration(1, [](PrettyEngine::SerialObject* object) { object->RemoveSerializedField("empty"); });
+
+	PrettyEngine::SerialObject legacy;
+	legacy.Deserialize(toml, PrettyEngine::SerializationFormat::Toml);
+	schema.Apply(&legacy);
+
+	assert(legacy.serialSchemaVersion == 2);
+	assert(legacy.GetSerializedFieldValue("speed") == "2.5");
+	assert(legacy.GetSerializedFieldValue("lives") == "3");
+	assert(legacy.GetSerializedFieldValue("displayName") == "player one");
+	assert(!legacy.ContainSerializedField("name"));
+	assert(!legacy.ContainSerializedField("empty"));
+
+	for (auto format: { PrettyEngine::SerializationFormat::Toml, PrettyEngine::SerializationFormat::Binary }) {
+		PrettyEngine::SerialObject current;
+		current.Deserialize(legacy.Serialize(format), format);
+		assert(current.serialSchemaVersion == 2);
+		AssertSameFields(&legacy, &current);
+	}
+
+	// A kept slot is found again once a removed field shifted it.
+	{
+		auto shifted = CreateSample();
+		size_t slot = shifted.GetSerializedFieldSlot("same");
+		PrettyEngine::InternedString name = "same";
+
+		bool removed = shifted.RemoveSerializedField("name");
+		assert(removed);
+		assert(shifted.GetSerializedFieldAt(slot) == nullptr);
+
+		auto field = shifted.ResolveSerializedField(&slot, name);
+		assert(field != nullptr && field->name == name && field->value == "player one");
+		assert(slot == shifted.GetSerializedFieldSlot("same"));
+
+		removed = shifted.RemoveSerializedField("speed");
+		assert(removed);
+		field = shifted.ResolveSerializedField(&slot, name);
+		assert(field != nullptr && field->value == "player one");
+	}
+
+	return 0;
+}
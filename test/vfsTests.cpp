@@ -0,0 +1,112 @@
+/*
+ * Resolve files through loose, pack and builtin layers.
+*/
+
+#include <assert.h>
+
+#include <PrettyEngine/vfs.hpp>
+#include <PrettyEngine/assets/builtin.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+static std::vector<unsigned char> ToBytes(const std::string& text) {
+	return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+int main() {
+	const std::string directory = "./vfs_test/";
+	const std::string packPath = "./vfs_test.pak";
+
+	std::filesystem::create_directories(directory + "textures");
+	PrettyEngine::WriteFileString(directory + "textures/loose.txt", "loose");
+	PrettyEngine::WriteFileString(directory + "textures/both.txt", "loose override");
+
+	std::string repeated;
+	for (int i = 0; i < 100; i++) {
+		repeated += "pretty engine ";
+	}
+
+	PrettyEngine::PackWriter writer;
+	writer.Add("textures/both.txt", ToBytes("packed"), false);
+	writer.Add("textures/packed.txt", ToBytes("packed"), false);
+	writer.Add("textures/compressed.txt", ToBytes(repeated));
+	bool written = writer.Write(packPath);
+	assert(written);
+
+	static const unsigned char builtinData[] = { 'b', 'u', 'i', 'l', 't', 'i', 'n' };
+
+	PrettyEngine::VirtualFileSystem vfs;
+	auto loose = std::make_shared<PrettyEngine::DirectoryLayer>(directory);
+	auto pack = std::make_shared<PrettyEngine::PackLayer>(packPath);
+	auto builtins = std::make_shared<PrettyEngine::BuiltinLayer>();
+	builtins->Add("shaders/default.glsl", builtinData);
+
+	assert(pack->Valid());
+
+	// Mounted out of order on purpose, the priority decide.
+	vfs.Mount("public", pack, VFS_PRIORITY_PACK);
+	vfs.Mount("./public/", loose, VFS_PRIORITY_LOOSE);
+	vfs.Mount(VFS_BUILTIN_MOUNT, builtins, VFS_PRIORITY_BUILTIN);
+
+	auto text = vfs.ReadToString("./public/textures/loose.txt");
+	assert(text == "loose");
+	text = vfs.ReadToString("public/textures/both.txt");
+	assert(text == "loose override");
+	auto layer = vfs.Resolve("./public/textures/both.txt");
+	assert(layer == loose);
+
+	// Stored entries point into the pack, compressed ones are decompressed.
+	auto packed = vfs.Open("./public/textures/packed.txt");
+	assert(packed.Valid() && packed.Mapped());
+	assert(packed.ToVector() == ToBytes("packed"));
+
+	auto compressed = vfs.Open("./public/textures/compressed.txt");
+	assert(compressed.Valid() && !compressed.Mapped());
+	assert(compressed.ToVector() == ToBytes(repeated));
+
+	text = vfs.ReadToString("builtin/shaders/default.glsl");
+	assert(text == "builtin");
+
+	// Embedded assets are decompressed once, on first access.
+	auto loadedCount = PrettyEngine::GetBuiltinAssetLoadedCount();
+	bool exists = vfs.Exists("builtin/config.toml");
+	assert(exists);
+	assert(PrettyEngine::GetBuiltinAssetLoadedCount() == loadedCount);
+	text = vfs.ReadToString("builtin/config.toml");
+	assert(text == ASSET_BUILTIN_CONFIG);
+	assert(PrettyEngine::GetBuiltinAssetLoadedCount() == loadedCount + 1);
+	auto config = vfs.Open("builtin/config.toml");
+	assert(config.GetData().data() == PrettyEngine::GetBuiltinAssetData("config.toml").data());
+
+	// Only found paths are remembered, as they were asked.
+	exists = vfs.Exists("./public/textures/missing.txt");
+	assert(!exists);
+	auto missing = vfs.Open("./public/textures/missing.txt");
+	assert(!missing.Valid());
+	assert(vfs.GetResolvedCount() == 7);
+
+	// The pack can go while its files are in use.
+	vfs.Unmount(pack.get());
+	pack.reset();
+	assert(packed.ToVector() == ToBytes("packed"));
+	exists = vfs.Exists("./public/textures/packed.txt");
+	assert(!exists);
+	exists = vfs.Exists("./public/textures/both.txt");
+	assert(exists);
+
+	// A deleted loose file is found again in the next layer.
+	vfs.Mount("./public/", std::make_shared<PrettyEngine::PackLayer>(packPath), VFS_PRIORITY_PACK);
+	layer = vfs.Resolve("./public/textures/both.txt");
+	assert(layer == loose);
+	std::filesystem::remove(directory + "textures/both.txt");
+	text = vfs.ReadToString("./public/textures/both.txt");
+	assert(text == "packed");
+
+	std::filesystem::remove_all(directory);
+	std::remove(packPath.c_str());
+
+	return 0;
+}
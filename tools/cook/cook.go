@@ -0,0 +1,447 @@
+// Convert the public assets into runtime-ready files, read by include/PrettyEngine/cooked.hpp
+// Only the inputs whose content changed since the last run are cooked again.
+
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"crypto/sha256"
+	"encoding/binary"
+	"encoding/hex"
+	"encoding/json"
+	"flag"
+	"fmt"
+	"image"
+	"image/draw"
+	_ "image/jpeg"
+	_ "image/png"
+	"io/fs"
+	"log"
+	"math"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+)
+
+const (
+	cookedVersion   = 1
+	cookedAlignment = 16
+	// Change it when a converter change, to cook everything again.
+	cookerRevision = "1"
+	manifestName   = "manifest.json"
+)
+
+type Converter struct {
+	extension string
+	cook      func(data []byte) ([]byte, error)
+}
+
+type ManifestEntry struct {
+	Hash   string `json:"hash"`
+	Output string `json:"output"`
+}
+
+type Manifest struct {
+	Revision string                   `json:"revision"`
+	Entries  map[string]ManifestEntry `json:"entries"`
+}
+
+func main() {
+	input := flag.String("input", "../../assets/ENGINE_PUBLIC", "Directory of the source assets")
+	output := flag.String("output", "../../assets/ENGINE_PUBLIC/cooked", "Directory of the cooked assets, must match COOKED_DIRECTORY")
+	localization := flag.String("localization", "*localization*.csv", "Pattern of the localization files")
+	force := flag.Bool("force", false, "Cook everything, even the unchanged inputs")
+	flag.Parse()
+
+	manifest := LoadManifest(*output)
+	if *force || manifest.Revision != cookerRevision {
+		manifest.Entries = map[string]ManifestEntry{}
+	}
+	manifest.Revision = cookerRevision
+
+	outputAbsolute, _ := filepath.Abs(*output)
+
+	cooked, skipped := 0, 0
+	seen := map[string]bool{}
+
+	err := filepath.WalkDir(*input, func(path string, entry fs.DirEntry, err error) error {
+		if err != nil {
+			return err
+		}
+
+		if entry.IsDir() {
+			if absolute, _ := filepath.Abs(path); absolute == outputAbsolute {
+				return filepath.SkipDir
+			}
+			return nil
+		}
+
+		converter := FindConverter(entry.Name(), *localization)
+		if converter == nil {
+			return nil
+		}
+
+		relative, err := filepath.Rel(*input, path)
+		if err != nil {
+			return err
+		}
+		relative = filepath.ToSlash(relative)
+		seen[relative] = true
+
+		data, err := os.ReadFile(path)
+		if err != nil {
+			return err
+		}
+
+		hash := sha256.Sum256(data)
+		hashText := hex.EncodeToString(hash[:])
+		outputPath := relative + converter.extension
+
+		if previous, ok := manifest.Entries[relative]; ok && previous.Hash == hashText {
+			if _, err := os.Stat(filepath.Join(*output, previous.Output)); err == nil {
+				skipped++
+				return nil
+			}
+		}
+
+		result, err := converter.cook(data)
+		if err != nil {
+			log.Print("Failed to cook ", relative, ": ", err)
+			return nil
+		}
+
+		destination := filepath.Join(*output, outputPath)
+		if err := os.MkdirAll(filepath.Dir(destination), 0755); err != nil {
+			return err
+		}
+		if err := os.WriteFile(destination, result, 0644); err != nil {
+			return err
+		}
+
+		manifest.Entries[relative] = ManifestEntry{Hash: hashText, Output: outputPath}
+		cooked++
+		return nil
+	})
+
+	if err != nil {
+		log.Fatal(err)
+	}
+
+	// Remove the outputs of the deleted inputs.
+	for relative, entry := range manifest.Entries {
+		if !seen[relative] {
+			os.Remove(filepath.Join(*output, entry.Output))
+			delete(manifest.Entries, relative)
+		}
+	}
+
+	SaveManifest(*output, manifest)
+
+	log.Print("Cooked ", cooked, " assets, ", skipped, " unchanged.")
+}
+
+func FindConverter(name string, localizationPattern string) *Converter {
+	switch strings.ToLower(filepath.Ext(name)) {
+	case ".png", ".jpg", ".jpeg":
+		return &Converter{extension: ".ptex", cook: CookTexture}
+	case ".obj":
+		return &Converter{extension: ".pmesh", cook: CookMesh}
+	case ".csv":
+		if match, _ := filepath.Match(localizationPattern, name); match {
+			return &Converter{extension: ".ploc", cook: CookLocalization}
+		}
+	}
+	return nil
+}
+
+func LoadManifest(output string) Manifest {
+	manifest := Manifest{Entries: map[string]ManifestEntry{}}
+
+	data, err := os.ReadFile(filepath.Join(output, manifestName))
+	if err == nil {
+		json.Unmarshal(data, &manifest)
+	}
+	if manifest.Entries == nil {
+		manifest.Entries = map[string]ManifestEntry{}
+	}
+	return manifest
+}
+
+func SaveManifest(output string, manifest Manifest) {
+	data, err := json.MarshalIndent(manifest, "", "\t")
+	if err != nil {
+		log.Fatal(err)
+	}
+	if err := os.MkdirAll(output, 0755); err != nil {
+		log.Fatal(err)
+	}
+	if err := os.WriteFile(filepath.Join(output, manifestName), data, 0644); err != nil {
+		log.Fatal(err)
+	}
+}
+
+func Align(buffer *bytes.Buffer) {
+	for buffer.Len()%cookedAlignment != 0 {
+		buffer.WriteByte(0)
+	}
+}
+
+func WriteHeader(buffer *bytes.Buffer, magic string) {
+	buffer.WriteString(magic)
+	binary.Write(buffer, binary.LittleEndian, uint32(cookedVersion))
+}
+
+// Texture: RGBA8 pixels with every mip level down to 1x1.
+
+type MipLevel struct {
+	width  int
+	height int
+	pixels []byte
+}
+
+func CookTexture(data []byte) ([]byte, error) {
+	source, _, err := image.Decode(bytes.NewReader(data))
+	if err != nil {
+		return nil, err
+	}
+
+	bounds := source.Bounds()
+	rgba := image.NewNRGBA(image.Rect(0, 0, bounds.Dx(), bounds.Dy()))
+	draw.Draw(rgba, rgba.Bounds(), source, bounds.Min, draw.Src)
+
+	levels := []MipLevel{{width: bounds.Dx(), height: bounds.Dy(), pixels: rgba.Pix}}
+	for {
+		last := levels[len(levels)-1]
+		if last.width == 1 && last.height == 1 {
+			break
+		}
+		levels = append(levels, Downsample(last))
+	}
+
+	var buffer bytes.Buffer
+	WriteHeader(&buffer, "PETX")
+	binary.Write(&buffer, binary.LittleEndian, uint32(levels[0].width))
+	binary.Write(&buffer, binary.LittleEndian, uint32(levels[0].height))
+	binary.Write(&buffer, binary.LittleEndian, uint32(4))
+	binary.Write(&buffer, binary.LittleEndian, uint32(len(levels)))
+
+	// The offsets are known once the table is written.
+	tableStart := buffer.Len()
+	buffer.Write(make([]byte, len(levels)*24))
+
+	for index, level := range levels {
+		Align(&buffer)
+		entry := buffer.Bytes()[tableStart+index*24:]
+		binary.LittleEndian.PutUint64(entry[0:8], uint64(buffer.Len()))
+		binary.LittleEndian.PutUint64(entry[8:16], uint64(len(level.pixels)))
+		binary.LittleEndian.PutUint32(entry[16:20], uint32(level.width))
+		binary.LittleEndian.PutUint32(entry[20:24], uint32(level.height))
+		buffer.Write(level.pixels)
+	}
+
+	return buffer.Bytes(), nil
+}
+
+// Average 2x2 blocks, the last row or column is repeated for odd sizes.
+func Downsample(level MipLevel) MipLevel {
+	width := max(level.width/2, 1)
+	height := max(level.height/2, 1)
+	pixels := make([]byte, width*height*4)
+
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			for channel := 0; channel < 4; channel++ {
+				sum := 0
+				for dy := 0; dy < 2; dy++ {
+					for dx := 0; dx < 2; dx++ {
+						sx := min(x*2+dx, level.width-1)
+						sy := min(y*2+dy, level.height-1)
+						sum += int(level.pixels[(sy*level.width+sx)*4+channel])
+					}
+				}
+				pixels[(y*width+x)*4+channel] = byte((sum + 2) / 4)
+			}
+		}
+	}
+
+	return MipLevel{width: width, height: height, pixels: pixels}
+}
+
+// Mesh: triangulated vertices in the layout of PrettyEngine::Vertex and u32 indices.
+
+type VertexKey struct {
+	position int
+	uv       int
+}
+
+func ObjIndex(value string, count int) (int, error) {
+	index, err := strconv.Atoi(value)
+	if err != nil {
+		return 0, err
+	}
+	if index < 0 {
+		index = count + index
+	} else {
+		index--
+	}
+	if index < 0 || index >= count {
+		return 0, fmt.Errorf("index out of range: %s", value)
+	}
+	return index, nil
+}
+
+func CookMesh(data []byte) ([]byte, error) {
+	var positions [][3]float32
+	var uvs [][2]float32
+
+	var vertices []float32
+	var indices []uint32
+	known := map[VertexKey]uint32{}
+
+	scanner := bufio.NewScanner(bytes.NewReader(data))
+	for scanner.Scan() {
+		fields := strings.Fields(scanner.Text())
+		if len(fields) == 0 {
+			continue
+		}
+
+		switch fields[0] {
+		case "v":
+			var position [3]float32
+			for i := 0; i < 3 && i+1 < len(fields); i++ {
+				value, err := strconv.ParseFloat(fields[i+1], 32)
+				if err != nil {
+					return nil, err
+				}
+				position[i] = float32(value)
+			}
+			positions = append(positions, position)
+		case "vt":
+			var uv [2]float32
+			for i := 0; i < 2 && i+1 < len(fields); i++ {
+				value, err := strconv.ParseFloat(fields[i+1], 32)
+				if err != nil {
+					return nil, err
+				}
+				uv[i] = float32(value)
+			}
+			uvs = append(uvs, uv)
+		case "f":
+			var face []uint32
+			for _, corner := range fields[1:] {
+				parts := strings.Split(corner, "/")
+
+				key := VertexKey{uv: -1}
+				var err error
+				if key.position, err = ObjIndex(parts[0], len(positions)); err != nil {
+					return nil, err
+				}
+				if len(parts) > 1 && parts[1] != "" {
+					if key.uv, err = ObjIndex(parts[1], len(uvs)); err != nil {
+						return nil, err
+					}
+				}
+
+				index, ok := known[key]
+				if !ok {
+					index = uint32(len(vertices) / 9)
+					known[key] = index
+
+					position := positions[key.position]
+					uv := [2]float32{}
+					if key.uv >= 0 {
+						uv = uvs[key.uv]
+					}
+					vertices = append(vertices, position[0], position[1], position[2], 1, 1, 1, 1, uv[0], uv[1])
+				}
+				face = append(face, index)
+			}
+
+			// Fan triangulation of convex polygons.
+			for i := 1; i+1 < len(face); i++ {
+				indices = append(indices, face[0], face[i], face[i+1])
+			}
+		}
+	}
+
+	if err := scanner.Err(); err != nil {
+		return nil, err
+	}
+
+	var buffer bytes.Buffer
+	WriteHeader(&buffer, "PEMS")
+	binary.Write(&buffer, binary.LittleEndian, uint32(len(vertices)/9))
+	binary.Write(&buffer, binary.LittleEndian, uint32(len(indices)))
+
+	offsets := buffer.Len()
+	buffer.Write(make([]byte, 16))
+
+	Align(&buffer)
+	vertexOffset := buffer.Len()
+	for _, value := range vertices {
+		binary.Write(&buffer, binary.LittleEndian, math.Float32bits(value))
+	}
+
+	Align(&buffer)
+	indexOffset := buffer.Len()
+	binary.Write(&buffer, binary.LittleEndian, indices)
+
+	binary.LittleEndian.PutUint64(buffer.Bytes()[offsets:], uint64(vertexOffset))
+	binary.LittleEndian.PutUint64(buffer.Bytes()[offsets+8:], uint64(indexOffset))
+
+	return buffer.Bytes(), nil
+}
+
+// Localization: the lines already split, with the same rules as PrettyEngine::ParseCSVLine.
+
+func ParseCSVLine(line string) []string {
+	var out []string
+	var buffer []byte
+	var last byte = ' '
+
+	for i := 0; i < len(line); i++ {
+		c := line[i]
+		if c == ';' && last == '/' {
+			buffer[len(buffer)-1] = ';'
+		} else if c != ';' {
+			buffer = append(buffer, c)
+		} else {
+			out = append(out, string(buffer))
+			buffer = buffer[:0]
+		}
+		last = c
+	}
+	if len(buffer) > 0 {
+		out = append(out, string(buffer))
+	}
+	return out
+}
+
+func WriteVarUint(buffer *bytes.Buffer, value uint64) {
+	var bytes [binary.MaxVarintLen64]byte
+	size := binary.PutUvarint(bytes[:], value)
+	buffer.Write(bytes[:size])
+}
+
+func CookLocalization(data []byte) ([]byte, error) {
+	// Like Localization::LoadString, a line is only kept once its end of line is read.
+	lines := strings.Split(string(data), "\n")
+	lines = lines[:len(lines)-1]
+
+	var buffer bytes.Buffer
+	WriteHeader(&buffer, "PELC")
+	binary.Write(&buffer, binary.LittleEndian, uint32(len(lines)))
+
+	for _, line := range lines {
+		columns := ParseCSVLine(line)
+		WriteVarUint(&buffer, uint64(len(columns)))
+		for _, column := range columns {
+			WriteVarUint(&buffer, uint64(len(column)))
+			buffer.WriteString(column)
+		}
+	}
+
+	return buffer.Bytes(), nil
+}
@@ -12,6 +12,7 @@ import (
 
 func main() {
 	GenerateShadersHeader()
+	GenerateUniformsHeader()
 	GenerateCustomObjectScript()
 }
 
@@ -84,6 +85,79 @@ func GenerateShadersHeader() {
 	}
 }
 
+/// Generate the enum of the uniforms resolved by each shader program, from the uniforms.csv builtin asset
+func GenerateUniformsHeader() {
+	_, executable, _, _ := runtime.Caller(0)
+
+	directory := filepath.Dir(executable)
+
+	content, err := os.ReadFile(filepath.Join(directory, "../../assets/ENGINE_BUILTIN/uniforms.csv"))
+
+	if err != nil {
+		log.Fatal(err)
+	}
+
+	var keys []string
+	var names []string
+	seen := make(map[string]bool)
+
+	for _, line := range strings.Split(strings.ReplaceAll(string(content), "\r", ""), "\n") {
+		fields := strings.Split(line, ";")
+		if len(fields) < 2 || fields[0] == "" {
+			continue
+		}
+
+		if seen[fields[0]] {
+			log.Print("Duplicated uniform ignored: " + fields[0])
+			continue
+		}
+		seen[fields[0]] = true
+
+		keys = append(keys, fields[0])
+		names = append(names, fields[1])
+	}
+
+	var output string
+
+	output += "#pragma once\n\n"
+
+	output += "// Generated from assets/ENGINE_BUILTIN/uniforms.csv by tools/generateFiles\n\n"
+
+	output += "namespace PrettyEngine {\n"
+
+	output += "\t/// Uniforms resolved once when a shader program is linked, index of GLShaderProgramRefs::uniformLocations.\n"
+	output += "\tenum class Uniform {\n"
+	for _, key := range keys {
+		output += "\t\t" + key + ",\n"
+	}
+	output += "\t\tCount,\n"
+	output += "\t};\n\n"
+
+	output += "\t/// Name of each Uniform in the key of GLShaderProgramRefs::uniforms.\n"
+	output += "\tstatic const char* const uniformKeys[] = {\n"
+	for _, key := range keys {
+		output += "\t\t\"" + key + "\",\n"
+	}
+	output += "\t};\n\n"
+
+	output += "\t/// Name of each Uniform in the shaders.\n"
+	output += "\tstatic const char* const uniformNames[] = {\n"
+	for _, name := range names {
+		output += "\t\t\"" + name + "\",\n"
+	}
+	output += "\t};\n"
+
+	output += "}\n"
+
+	err = os.WriteFile(filepath.Join(directory, "../../include/PrettyEngine/render/uniforms.hpp"), []byte(output), 0644)
+
+	if err != nil {
+		log.Fatal(err)
+	} else {
+		log.Print("Succeed to generate header: uniforms.hpp")
+	}
+}
+
 /// Generate the required function for object that will be generated in runtime
 func GenerateCustomObjectScript() {
 	log.Print("Generate PropertyEditor files...")
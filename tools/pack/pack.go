@@ -0,0 +1,177 @@
+// Pack the public assets in a single archive, read by PrettyEngine::PackFile (include/PrettyEngine/pack.hpp)
+
+package main
+
+import (
+	"bytes"
+	"compress/zlib"
+	"encoding/binary"
+	"flag"
+	"hash/fnv"
+	"io/fs"
+	"log"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+)
+
+const (
+	packMagic         = "PEPK"
+	packVersion       = 1
+	packAlignment     = 16
+	packHeaderSize    = 32
+	compressionStored = 0
+	compressionZlib   = 1
+	minimumSaving     = 0.1
+)
+
+// Already compressed formats, trying zlib on them is a waste of time.
+var storedExtensions = map[string]bool{
+	".png":  true,
+	".jpg":  true,
+	".jpeg": true,
+	".ogg":  true,
+	".mp3":  true,
+	".flac": true,
+}
+
+type Entry struct {
+	name         string
+	hash         uint64
+	offset       uint64
+	data         []byte
+	originalSize uint64
+	compression  uint32
+	nameOffset   uint32
+}
+
+func main() {
+	input := flag.String("input", "../../assets/ENGINE_PUBLIC", "Directory to pack")
+	output := flag.String("output", "public.pak", "Pack to write")
+	flag.Parse()
+
+	entries := CollectEntries(*input)
+	WritePack(*output, entries)
+
+	log.Print("Packed ", len(entries), " files in: ", *output)
+}
+
+func Hash(name string) uint64 {
+	hash := fnv.New64a()
+	hash.Write([]byte(name))
+	return hash.Sum64()
+}
+
+func Compress(data []byte) ([]byte, bool) {
+	var buffer bytes.Buffer
+	writer, _ := zlib.NewWriterLevel(&buffer, zlib.BestCompression)
+	writer.Write(data)
+	writer.Close()
+
+	if float64(buffer.Len()) > float64(len(data))*(1.0-minimumSaving) {
+		return nil, false
+	}
+	return buffer.Bytes(), true
+}
+
+func CollectEntries(input string) []*Entry {
+	var entries []*Entry
+
+	err := filepath.WalkDir(input, func(path string, entry fs.DirEntry, err error) error {
+		if err != nil {
+			return err
+		}
+		if entry.IsDir() {
+			return nil
+		}
+
+		relative, err := filepath.Rel(input, path)
+		if err != nil {
+			return err
+		}
+
+		data, err := os.ReadFile(path)
+		if err != nil {
+			return err
+		}
+
+		newEntry := &Entry{
+			name:         filepath.ToSlash(relative),
+			data:         data,
+			originalSize: uint64(len(data)),
+			compression:  compressionStored,
+		}
+		newEntry.hash = Hash(newEntry.name)
+
+		if len(data) > 0 && !storedExtensions[strings.ToLower(filepath.Ext(path))] {
+			if compressed, ok := Compress(data); ok {
+				newEntry.data = compressed
+				newEntry.compression = compressionZlib
+			}
+		}
+
+		entries = append(entries, newEntry)
+		return nil
+	})
+
+	if err != nil {
+		log.Fatal(err)
+	}
+
+	return entries
+}
+
+func Align(buffer *bytes.Buffer) {
+	for buffer.Len()%packAlignment != 0 {
+		buffer.WriteByte(0)
+	}
+}
+
+func WritePack(output string, entries []*Entry) {
+	var buffer bytes.Buffer
+	buffer.Write(make([]byte, packHeaderSize))
+
+	var names bytes.Buffer
+	for _, entry := range entries {
+		Align(&buffer)
+		entry.offset = uint64(buffer.Len())
+		entry.nameOffset = uint32(names.Len())
+		buffer.Write(entry.data)
+		names.WriteString(entry.name)
+	}
+
+	index := make([]*Entry, len(entries))
+	copy(index, entries)
+	sort.SliceStable(index, func(a, b int) bool {
+		return index[a].hash < index[b].hash
+	})
+
+	Align(&buffer)
+	indexOffset := uint64(buffer.Len())
+	for _, entry := range index {
+		binary.Write(&buffer, binary.LittleEndian, entry.hash)
+		binary.Write(&buffer, binary.LittleEndian, entry.offset)
+		binary.Write(&buffer, binary.LittleEndian, uint64(len(entry.data)))
+		binary.Write(&buffer, binary.LittleEndian, entry.originalSize)
+		binary.Write(&buffer, binary.LittleEndian, entry.nameOffset)
+		binary.Write(&buffer, binary.LittleEndian, uint32(len(entry.name)))
+		binary.Write(&buffer, binary.LittleEndian, entry.compression)
+		binary.Write(&buffer, binary.LittleEndian, uint32(0))
+	}
+
+	namesOffset := uint64(buffer.Len())
+	buffer.Write(names.Bytes())
+
+	pack := buffer.Bytes()
+	copy(pack[0:4], packMagic)
+	binary.LittleEndian.PutUint32(pack[4:8], packVersion)
+	binary.LittleEndian.PutUint32(pack[8:12], uint32(len(entries)))
+	binary.LittleEndian.PutUint32(pack[12:16], 0)
+	binary.LittleEndian.PutUint64(pack[16:24], indexOffset)
+	binary.LittleEndian.PutUint64(pack[24:32], namesOffset)
+
+	if err := os.WriteFile(output, pack, 0644); err != nil {
+		log.Fatal(err)
+	}
+}